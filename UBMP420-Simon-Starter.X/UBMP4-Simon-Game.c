@@ -16,40 +16,95 @@
 #include    "stdbool.h"         // Include Boolean (true/false) definitions
 
 #include    "UBMP420.h"         // Include UBMP4.2 constant and function definitions
+#include    "UBMP420-tone.h"    // Include interrupt-driven tone generator
+#include    "UBMP420-tick.h"    // Include 1 ms system tick and task scheduler
+#include    "UBMP420-buttons.h" // Include debounced button scanner
+#include    "UBMP420-random.h"  // Include random number generator
+#include    "UBMP420-adc.h"     // Include ADC scan engine
+#include    "UBMP420-pwm.h"     // Include software PWM LED dimmer
+#include    "UBMP420-melody.h"  // Include melody and light sequencer
+#include    "UBMP420-stats.h"   // Include game statistics
+#include    "UBMP420-store.h"   // Include persistent record store
 
 // TODO Set linker ROM ranges to 'default,-0-7FF' under "Memory model" pull-down.
 // TODO Set linker code offset to '800' under "Additional options" pull-down.
 
 // Program constants
 #define pressed 0               // Switch pressed logic state
-#define timeOut 2400            // Idle time-out duration (50ms intervals - 1200/min)
-#define patternLength 42        // Total number of pattern steps to match
+#define timeOut 120             // Idle time-out duration (s)
+#ifndef patternLength
+#define patternLength 42        // Total number of pattern steps to match (can be
+#endif                          // set in the build, e.g. -DpatternLength=400)
+//#define patternFromSeed         // Regenerate pattern from its seed (no pattern
+                                // memory, patternLength can be up to 65535)
+//#define scoreTally              // Show the score as a tally of 1 s flashes
+                                // instead of as decimal digits in binary
+#define turnDelay 1000          // Delay before each new turn (ms)
+#define stepGap 500             // Gap between played pattern steps (ms)
 
 //Game modes
 #define off 0                   // Game off
 #define simon 1                 // Traditional pattern matching game mode
                                 // Create additional (optional) game modes here
 
+// Simon game states (each state runs once per tick until it changes state)
+#define turnWait 0              // Waiting to add the next pattern step
+#define playStep 1              // Playing a pattern step (LED and sound on)
+#define playGap 2               // Pause after a played pattern step
+#define getGuess 3              // Waiting for the player to press a button
+#define showGuess 4             // Guess LED and sound on, waiting for release
+#define showMiss 5              // Wrong guess LED and sound on
+#define loseWait 6              // Pause before the game lose sequence
+#define showStart 7             // Game start song, then wait for release
+#define showLose 8              // Game lose song
+#define showEnd 9               // Game win song or score, then game off
+
 // Program variables
 unsigned char mode = off;       // Current game mode. Start game in off mode
-__persistent unsigned char randomSeed;  // Random seed will be updated from TMR0
 unsigned char button;           // Button ID (0 = none, 1 = SW1, etc.)
-unsigned char pattern[patternLength];	// Pattern memory
-unsigned char step = 0;         // Current pattern step (index) counter
-unsigned char maxStep = 0;      // Highest pattern step (score) achieved by player
-unsigned int idle = 0;          // Idle time-out counter for low-power shut-down
-
-// Declare random number functions and variables
-extern int rand();              // MPLAB random number functions
-extern void srand(unsigned int);
-unsigned int newSeed;           // New random number generator seed values
-
-// Interrupt function. Processes IOC interrupts and wakes game from nap/sleep.
+button_event_t buttonEvent;     // Button event from the button scanner
+#ifdef patternFromSeed
+uint16_t patternSeed;           // Pattern generator seed (never 0)
+uint16_t patternState;          // Pattern generator state at the current step
+#else
+unsigned char pattern[(patternLength + 3) / 4];	// Pattern memory, 4 steps per byte
+uint16_t patternRead;           // Pattern memory read position
+#endif
+unsigned char stepButton;       // Button of the current pattern step (1-4)
+melody_event_t scoreSong[16];   // Score display song (built by score_song())
+uint16_t step = 0;              // Current pattern step (index) counter
+uint16_t maxStep = 0;           // Highest pattern step (score) achieved by player
+unsigned char state = turnWait; // Current simon game state
+uint16_t stateTimer = 0;        // State delay timer (ms), counts down each tick
+uint16_t taskTime = 0;          // Tick time (ms) of the last simon_task() run
+const unsigned char sensors[] = {ANQ1, ANTIM};  // ADC scan list
+#define lightSensor 0           // sensors[] index of phototransistor Q1
+#define tempSensor 1            // sensors[] index of temperature indicator
+#define sensorBits 2            // Oversample sensors to 12-bit results
+#define lightShift 7            // Light level (12-bit) to LED brightness scale
+#define lightMin 2              // Lowest LED brightness (in the dark)
+
+// Interrupt function. Plays tones from Timer1, steps the LED PWM and counts
+// Timer2 system ticks, and processes IOC interrupts to wake game from nap/sleep.
 
 void __interrupt() wake(void)
 {
-    di();                       // Disable interrupts
-	if(IOCIF == 1 && IOCIE == 1)	// When an IOC interrupt occurs...
+    if(TMR1IF == 1 && TMR1IE == 1)  // When a tone timer interrupt occurs...
+    {
+        tone_isr();             // Toggle beeper for the next half-period
+    }
+    else if(TMR2IF == 1 && TMR2IE == 1) // When a PWM step or tick occurs...
+    {
+        if(pwm_isr())           // Output the next LED PWM step, and if it's
+        {                       // a tick, count it and signal the scheduler
+            tick_isr();
+        }
+    }
+    else if(ADIF == 1 && ADIE == 1) // When an ADC conversion finishes...
+    {
+        adc_isr();              // Store the sample and select the next channel
+    }
+	else if(IOCIF == 1 && IOCIE == 1)	// When an IOC interrupt occurs...
 	{
         IOCAF = 0;              // Clear IOC port A interrupt flag
         IOCBF = 0;              // Clear IOC port B interrupt flag
@@ -59,7 +114,7 @@ void __interrupt() wake(void)
     {
         IOCAN = 0b00001000;     // Other interrupt? Only allow IOC on pushbuttons
         IOCBN = 0b11110000;
-		INTCON = 0b00001000;
+		INTCON = 0b01001000;    // (keep peripheral interrupts on for tones)
     }
 }
 
@@ -67,206 +122,618 @@ void __interrupt() wake(void)
 
 void nap(void)
 {
-    LED1 = 1;                   // Turn power LED off
-    LATC = 0;
+    pwm_set(PWM_D1 | PWM_LEDS, 0);  // Turn power LED and LEDs off, and
+    while(pwm_busy())           // wait for the PWM engine to stop
+        WAIT_EVENT();
     IOCAF = 0;                  // Clear S1 IOC interrupt flag
     IOCBF = 0;                  // Clear S2-S5 IOC interrupt flags
     IOCIF = 0;                  // Clear global IOC interrupt flag
-    ei();                       // Enable interrupts
+    TMR2ON = 0;                 // Stop system tick so it can't wake the PIC
+    TMR2IF = 0;
+    adc_scan_stop();            // Turn off ADC and temperature indicator
+    store_flush();              // Save the last game (stalls for a few ms)
+    OSC_sleep_clock();          // Wake up on HFINTOSC, without the PLL delay
+    di();                       // Run on from SLEEP before the IOC interrupt
+    T1CON = 0b00000001;         // Timer1 (idle tone timer) times the wake-up:
+    TMR1 = 0;                   // FOSC/4, 1:1, stopped in sleep (250 ns/count)
     SLEEP();
+    LED1 = 0;                   // Turn power LED on without waiting for PLL
+    TMR1ON = 0;
+    stats_wake(TMR1 * 250);     // Time from waking to the LED write (ns)
+    ei();                       // Clear the IOC flags in the interrupt
+    tone_config();              // Give Timer1 back to the tone generator
+    OSC_wake_clock();           // Switch to the PLL when it's ready
+    while(!OSC_fast())          // PLL locks while the LED is already on
+        WAIT_EVENT();
+    TMR2ON = 1;                 // Restart system tick at 48 MHz
+    pwm_set(PWM_D1, PWM_LEVELS);    // Keep power LED on
+    adc_scan_start(sensors, sizeof(sensors));
 }
-    
-// get_button function. Return the code of a pressed button. 0 = no button.
 
-unsigned char get_button(void)      // Return code of pressed button or 0 if
-{                                   // no buttons are pressed
-    if(SW2 == pressed)
+// Doze function. Sleep for a few ms between ticks when the game is only waiting
+// for a button press or for a long delay to end, instead of running at 48 MHz.
+// A button press or the watchdog wakes the PIC, and tick_sleep() keeps the
+// tick time (and stateTimer) counting while asleep. Waiting for a guess uses
+// the 1 ms watchdog period, so the press that ends the sleep is timed to
+// within half a millisecond. The PIC stays on the 16 MHz HFINTOSC between
+// sleeps and only waits for the PLL once there is something to do. Timer2
+// stops in sleep, so the game can't doze while dimmed LEDs need the PWM engine.
+
+void doze(void)
+{
+    unsigned char wdt = 0;      // Watchdog period to sleep for (0 = don't)
+
+    di();
+    if(mode == off || tone_busy() || pwm_busy() || random_seeding())
     {
-        return(1);
-    }
-    else if(SW3 == pressed)
+        wdt = 0;                // Nothing to doze through (or a tone playing,
+    }                           // LEDs dimmed or ADC scans to mix into the
+                                // random numbers, which stop in sleep)
+    else if(state == getGuess)  // Waiting for a guess? Sleep until a press
     {
-        return(2);
+        if(buttons_idle())      // Check buttons with interrupts off, so a
+        {                       // press from now on wakes the PIC at once
+            wdt = TICK_WDT_SHORT;
+        }
     }
-    else if(SW4 == pressed)
+    else if((state == turnWait || state == playGap || state == loseWait) &&
+            stateTimer > 2 * TICK_SLEEP_MS)
     {
-        return(3);
+        wdt = TICK_WDT_LONG;    // Sleep through most of a long delay
     }
-    else if(SW5 == pressed)
+
+    if(wdt != 0)
     {
-        return(4);
+        tick_sleep(wdt);
     }
     else
     {
-        return(0);
+        tick_wake();            // Back to 48 MHz before the next tick's work
     }
+    ei();
+}
+    
+// Button and LED tables. SW2-SW5 are in RB4-RB7 and LEDs D2-D5 are in
+// LATC4-LATC7, so a chord of buttons read from PORTB lights the matching
+// chord of LEDs with the same bits.
+
+const unsigned char buttonCode[16] =    // Lowest button in each chord (index
+{                                       // = buttons bits 4-7, bit 0 = SW2)
+    0, 1, 2, 1, 3, 1, 2, 1, 4, 1, 2, 1, 3, 1, 2, 1
+};
+const unsigned char ledBit[5] =         // LED of each button code (0 = none)
+{
+    0, PWM_LED2, PWM_LED3, PWM_LED4, PWM_LED5
+};
+
+// get_buttons function. Return the chord of pressed buttons (SW2-SW5, in the
+// PWM_LED bit of their LED). 0 = no buttons.
+
+unsigned char get_buttons(void)
+{
+    return(~PORTB & BUTTON_PINS);   // One read of all four switches
+}
+
+// get_button function. Return the code of a pressed button (the lowest one
+// in a chord). 0 = no button.
+
+unsigned char get_button(void)
+{
+    return(buttonCode[get_buttons() >> 4]);
 }
 
-// LED function. Light one of the 4 LEDs. 0 = all LEDs off.
+// LED function. Light one of the 4 LEDs (at the ambient brightness), adding
+// it to those already lit. 0 = all LEDs off.
 
 void LED(unsigned char num)
 {
-    if(num == 1)
-    {
-        LED2 = 1;
-    }
-    else if(num == 2)
+    if(num == 0 || num > 4)
     {
-        LED3 = 1;
-    }
-    else if(num == 3)
-    {
-        LED4 = 1;
-    }
-    else if(num == 4)
-    {
-        LED5 = 1;
+        pwm_leds(0);
     }
     else
     {
-        LED2 = 0;
-        LED3 = 0;
-        LED4 = 0;
-        LED5 = 0;
+        pwm_set(ledBit[num], PWM_LEVELS);
     }
 }
 
-// Music note functions. Plays note for requested cycles of time period.
+// Pattern functions. The pattern is played and matched in order, so its steps
+// are read back one after another from the first step.
+
+#ifdef patternFromSeed
+
+// Seed mode. Only the seed is stored. Each step comes from the next output of a
+// 16-bit xorshift generator, so restarting the generator from the seed replays
+// the same pattern.
+
+unsigned char pattern_draw(void)    // Advance generator, return the step (1-4)
+{
+    patternState ^= patternState << 7;
+    patternState ^= patternState >> 9;
+    patternState ^= patternState << 8;
+    return(((unsigned char)(patternState >> 8) & 0b00000011) + 1);
+}
+
+void pattern_new(void)          // Start a new, empty pattern
+{
+    maxStep = 0;
+}
 
-void note_E5(unsigned int per)  // Plays note E5 for requested number of cycles
+void pattern_add(void)          // Add a random step to the end of the pattern
 {
-    for(per; per != 0; per--)
+    if(maxStep == 0)            // (it's the next generator output)
     {
-        BEEPER = !BEEPER;
-        __delay_us(758);
+        patternSeed = random_next();    // Pick a new pattern (never 0)
     }
+    maxStep++;
 }
 
-void note_CS6(unsigned int per)  // Plays note C#6 for requested number of cycles
+unsigned char pattern_first(void)   // Return the first step (1-4)
 {
-    for(per; per != 0; per--)
+    patternState = patternSeed;
+    return(pattern_draw());
+}
+
+unsigned char pattern_next(void)    // Return the step after the last one read
+{
+    return(pattern_draw());
+}
+
+#else
+
+// Memory mode. Each pattern step (1-4) is stored as 2 bits, step 0 in bits 0-1
+// of pattern[0], step 1 in bits 2-3, and so on.
+
+unsigned char pattern_get(uint16_t num)     // Return pattern step num (1-4)
+{
+    unsigned char bits = pattern[num >> 2];
+
+    switch(num & 3)             // Shift the step down to bits 0-1
     {
-        BEEPER = !BEEPER;
-        __delay_us(451);
+        case 3:
+            bits = bits >> 2;
+        case 2:
+            bits = bits >> 2;
+        case 1:
+            bits = bits >> 2;
     }
+    return((bits & 0b00000011) + 1);
 }
 
-void note_A5(unsigned int per)  // Plays note A5 for requested number of cycles
+void pattern_new(void)          // Start a new, empty pattern
 {
-    for(per; per != 0; per--)
+    maxStep = 0;
+}
+
+void pattern_add(void)          // Add a random step to the end of the pattern
+{
+    unsigned char bits = (random_button() - 1) & 0b11;  // (only ever 2 bits)
+
+    switch(maxStep & 3)         // Shift the step up to its bit position
     {
-        BEEPER = !BEEPER;
-        __delay_us(568);
+        case 0:
+            pattern[maxStep >> 2] = bits;   // First step in a new byte
+            break;
+        case 3:
+            bits = bits << 2;
+        case 2:
+            bits = bits << 2;
+        case 1:
+            bits = bits << 2;
+            pattern[maxStep >> 2] = pattern[maxStep >> 2] | bits;
     }
+    maxStep++;
+}
+
+unsigned char pattern_first(void)   // Return the first step (1-4)
+{
+    patternRead = 0;
+    return(pattern_get(0));
+}
+
+unsigned char pattern_next(void)    // Return the step after the last one read
+{
+    patternRead++;
+    return(pattern_get(patternRead));
+}
+
+#endif
+
+// Music note function. Play a note (e.g. NOTE_A5) for the requested duration
+// (ms) and wait for the tone generator to finish.
+
+void play_note(unsigned char note, uint16_t dur)
+{
+    tone_note(note, dur);
+    while(tone_busy())
+        WAIT_EVENT();
 }
 
-void note_E6(unsigned int per)  // Plays note E6 for requested number of cycles
+// Sound and game status functions. Each button has its own note and sound
+// length.
+
+const unsigned char buttonNote[5] = {0, NOTE_E5, NOTE_CS6, NOTE_E6, NOTE_A5};
+const uint16_t buttonSoundMs[5] = {0, 287, 256, 287, 256};
+
+void sound(unsigned char num)   // Start selected note sound (does not wait)
 {
-    for(per; per != 0; per--)
+    if(num >= 1 && num <= 4)
     {
-        BEEPER = !BEEPER;
-        __delay_us(379);
+        tone_note(buttonNote[num], buttonSoundMs[num]);
     }
 }
 
-void note_low(unsigned int per) // Plays low note
+// Game sound and light effects (songs in program memory). Each event lights
+// the game LEDs in leds while its note plays.
+
+const melody_event_t startSong[] =    // Game start-up song
+{
+    {NOTE_E5, PWM_LED2, 152},
+    {NOTE_A5, PWM_LED2 | PWM_LED5, 114},
+    {NOTE_CS6, PWM_LED2 | PWM_LED5 | PWM_LED3, 90},
+    {NOTE_E6, PWM_LEDS, 76},
+    MELODY_END(0)
+};
+
+const melody_event_t winSong[] =        // Game win song
+{
+    {NOTE_E6, PWM_LEDS, 190},
+    {MELODY_REST, PWM_LEDS, 200},
+    {NOTE_E6, PWM_LEDS, 303},
+    MELODY_END(0)
+};
+
+const melody_event_t loseSong[] =      // Pattern fail. Game lose song
 {
-    for(per; per != 0; per--)
+    {NOTE_A4, 0, 568},
+    {MELODY_REST, 0, 500},
+    {NOTE_A3, 0, 909},
+    {MELODY_REST, 0, 500},
+    MELODY_END(0)
+};
+
+// Set event i of the score song and return the next event.
+
+unsigned char score_event(unsigned char i, unsigned char note, unsigned char leds, uint16_t ms)
+{
+    scoreSong[i].note = note;
+    scoreSong[i].leds = leds;
+    scoreSong[i].ms = ms;
+    return(i + 1);
+}
+
+#ifdef scoreTally
+
+// Add count 1 s flashes of led to the score song from event i. Returns the
+// event after them.
+
+unsigned char score_flashes(unsigned char i, unsigned char led, uint16_t count)
+{
+    if(count != 0)
     {
-        BEEPER = !BEEPER;
-        __delay_us(1136);
+        i = score_event(i, MELODY_REST, led, 500);  // Flash on...
+        i = score_event(i, MELODY_REST, 0, 500);    // ...and off...
+        i = score_event(i, MELODY_REPEAT, 2, count - 1);    // ...count times
     }
+    return(i);
 }
 
-void note_lower(unsigned int per)   // Plays lower note
+// Build the score song for score: a flash of D2 for each ten, D3 for five,
+// and D4 for each one. Takes a second per flash, e.g. 8 s for 39.
+
+void score_song(uint16_t score)
 {
-    for(per; per != 0; per--)
+    unsigned char i;
+
+    i = score_flashes(0, PWM_LED2, score / 10);     // Tens
+    score = score % 10;
+    i = score_flashes(i, PWM_LED3, score / 5);      // Five
+    i = score_flashes(i, PWM_LED4, score % 5);      // Ones
+    score_event(i, MELODY_REST, 0, 0);              // End
+}
+
+#else
+
+// Build the score song for score: each decimal digit from the first, in
+// binary on D2 (1), D3 (2), D4 (4) and D5 (8), with a click so that zeros
+// can be counted too. Takes 0.4 s per digit, e.g. 0.8 s for 39.
+
+void score_song(uint16_t score)
+{
+    unsigned char digits[5];
+    unsigned char count = 0;
+    unsigned char i = 0;
+    unsigned char leds;
+
+    do                          // Split into digits, last digit first
+    {
+        digits[count] = (unsigned char)(score % 10);
+        score = score / 10;
+        count++;
+    }
+    while(score != 0);
+
+    while(count != 0)           // Show each digit, first digit first
     {
-        BEEPER = !BEEPER;
-        __delay_us(2272);
-    }    
+        count--;
+        leds = (unsigned char)(digits[count] << 4); // D2-D5 are LATC4-LATC7
+        i = score_event(i, NOTE_A5, leds, 20);      // Click and show digit,
+        i = score_event(i, MELODY_REST, leds, 280); // hold it,
+        i = score_event(i, MELODY_REST, 0, 100);    // then a gap
+    }
+    score_event(i, MELODY_REST, 0, 0);              // End
 }
 
-// Sound and game status functions. 
+#endif
+
+// Saved data functions. The games played, best score and a random byte to
+// restart the generator from are saved in HEF after each game.
 
-void sound(unsigned char num)   // Play selected note sound
+void load_stats(void)
 {
-	if(num == 1)
-        note_E5(379);
-	else if(num == 2)
-		note_CS6(568);
-	else if(num == 3)
-		note_E6(758);
-	else if(num == 4)
-		note_A5(451);	
+    unsigned char saved[STORE_DATA];
+
+    if(store_init(saved))
+    {
+        stats_restore(saved[0] | (saved[1] << 8), saved[2] | (saved[3] << 8));
+        random_mix(saved[4]);
+    }
 }
 
-void game_start(void)           // Game start-up function
-{
-    LED(1);
-    note_E5(200);
-    LED(4);
-    note_A5(200);
-    LED(2);
-    note_CS6(200);
-    LED(3);
-    note_E6(200);
-    LED(0);
+void end_game(uint16_t score)       // Count the game and save the stats
+{
+    unsigned char saved[STORE_DATA];
+    uint16_t seed = random_next();
+    const stats_t *stats = stats_read();
+
+    stats_game_end(score);
+    saved[0] = (unsigned char)stats->games;
+    saved[1] = (unsigned char)(stats->games >> 8);
+    saved[2] = (unsigned char)stats->bestScore;
+    saved[3] = (unsigned char)(stats->bestScore >> 8);
+    saved[4] = (unsigned char)seed;     // (one byte is enough to restart
+                                        // from a new sequence)
+    store_write(saved);         // Written to HEF before the next nap
 }
 
-void game_win(void)             // Game win function
+// Skip function. Return true if a button was pressed to skip the rest of the
+// win song, lose song or score and start a new game right away.
+
+bool skip_pressed(void)
 {
-    LED(1);
-    LED(2);
-    LED(3);
-    LED(4);
-    note_E6(500);
-    __delay_ms(200);
-    note_E6(800);
-    LED(0);
+    return(buttons_get_event(&buttonEvent) && buttonEvent.press);
 }
 
-void game_lose(void)             // Pattern fail. Game lose function
+// Game tasks. Each task is called by the scheduler and must return without
+// waiting, so delays are counted down by stateTimer using the tick time.
+
+void simon_task(void)           // Simon game state machine (runs every tick)
 {
-    note_low(500);               // Sounds, lights?
-    __delay_ms(500);
-    note_lower(400);
-    __delay_ms(500);
-    
-    maxStep = maxStep -1;       // User step is 1 below maxStep
-    while(maxStep >= 10)        // Show score - tens digits
+    uint16_t elapsed = tick_ms() - taskTime;
+
+    taskTime = taskTime + elapsed;  // Count down the time since the last run
+    if(stateTimer > elapsed)    // (1 ms, or longer after dozing)
     {
-        LED(1);
-        __delay_ms(500);
-        LED(0);
-        __delay_ms(500);
-        maxStep = maxStep - 10;
+        stateTimer = stateTimer - elapsed;
     }
-    while(maxStep >= 5)         // Show score - fives digit
+    else
     {
-        LED(2);
-        __delay_ms(500);
-        LED(0);
-        __delay_ms(500);
-        maxStep = maxStep - 5;
+        stateTimer = 0;
     }
-    while(maxStep > 0)          // Show score - ones digits
+    stats_time(elapsed);        // Time the game being played
+
+    if(mode == off)
     {
-        LED(3);
-        __delay_ms(500);
-        LED(0);
-        __delay_ms(500);
-        maxStep = maxStep - 1;
+        LED(0);                 // Turn all game LEDs off
+        nap();                  // Sleep and wait for a button press (turns
+                                // power LED back on)
+        taskTime = tick_ms();   // Start timing from wake-up
+        melody_play(startSong); // Start game
+        mode = simon;
+        state = showStart;
+    }
+    else if(tick_idle_expired())    // No button pressed for timeOut seconds?
+    {
+        tick_idle_stop();       // Shut down to save power
+        end_game(maxStep - 1);  // (the unfinished turn doesn't count)
+        mode = off;
+    }
+    else if(state == showStart) // Play start song, wait for buttons released
+    {
+        if(!melody_busy() && get_buttons() == 0)
+        {
+            // Add code to switch to different game modes here
+
+            // Mix button release timing into the random numbers, then ADC
+            // noise from new sensor scans during the turn delay
+            random_seed();
+
+            pattern_new();      // Clear step count, start simon game mode
+            stats_game_start();
+            state = turnWait;
+            stateTimer = turnDelay;
+        }
+    }
+    else if(state == turnWait)  // Delay for each turn, then pick the next step
+    {
+        if(!random_seeding() && stateTimer == 0)    // (once seeded)
+        {
+            if(maxStep == patternLength)    // All steps matched? Win!
+            {
+                end_game(maxStep);
+                buttons_flush();
+                melody_play(winSong);
+                state = showEnd;
+            }
+            else                // Add a step and play the new pattern
+            {
+                pattern_add();
+                step = 0;
+                stepButton = pattern_first();
+                LED(stepButton);
+                sound(stepButton);
+                state = playStep;
+            }
+        }
+    }
+    else if(state == playStep)  // Wait for the step sound to end
+    {
+        if(!tone_busy())
+        {
+            LED(0);
+            stateTimer = stepGap;
+            state = playGap;
+        }
+    }
+    else if(state == playGap)   // Pause, then play the next step or get guesses
+    {
+        if(stateTimer == 0)
+        {
+            step++;
+            if(step != maxStep)
+            {
+                stepButton = pattern_next();
+                LED(stepButton);
+                sound(stepButton);
+                state = playStep;
+            }
+            else                // Let the user try to match the pattern
+            {
+                step = 0;
+                stepButton = pattern_first();
+                buttons_flush();    // Ignore presses made during the pattern
+                tick_idle_start(timeOut);   // Shut down if the player leaves
+                stats_ready(taskTime);  // Time the first guess from now
+                state = getGuess;
+            }
+        }
+    }
+    else if(state == getGuess)  // Wait for the next button press event
+    {
+        if(buttons_get_event(&buttonEvent) && buttonEvent.press)
+        {
+            button = buttonEvent.button;
+            stats_press(buttonEvent.time);
+            LED(button);        // Show button and start sound for each guess
+            sound(button);
+            if(button != stepButton)
+            {
+                tick_idle_stop();
+                state = showMiss;   // Uh, oh. Button didn't match pattern
+            }
+            else
+            {
+                step++;         // Pattern matched! Go on to the next step
+                if(step != maxStep)
+                {
+                    stepButton = pattern_next();
+                }
+                state = showGuess;
+            }
+        }
+    }
+    else if(state == showGuess) // Wait for the guess sound to end and release
+    {
+        if(!tone_busy())
+        {
+            LED(0);             // Turn LED off when the guess sound ends
+            if((buttons_held() & (1 << (button - 1))) == 0)
+            {
+                if(step == maxStep)
+                {
+                    tick_idle_stop();
+                    stateTimer = turnDelay; // Whole pattern matched, next turn
+                    state = turnWait;
+                }
+                else
+                {
+                    stats_ready(taskTime);  // Time the next guess from now
+                    state = getGuess;   // Presses queued meanwhile are kept
+                }
+            }
+        }
+    }
+    else if(state == showMiss)  // Wait for the wrong guess sound to end
+    {
+        if(!tone_busy())
+        {
+            LED(0);
+            stateTimer = stepGap;
+            state = loseWait;
+        }
+    }
+    else if(state == loseWait)  // Pause, then play game lose sequence
+    {
+        if(stateTimer == 0)
+        {
+            end_game(maxStep - 1);  // User step is 1 below maxStep
+            buttons_flush();    // A press from now on skips to a new game
+            melody_play(loseSong);
+            state = showLose;
+        }
+    }
+    else if(state == showLose)  // Play lose song, then show the score
+    {
+        if(skip_pressed())
+        {
+            melody_play(startSong); // Skip to a new game
+            state = showStart;
+        }
+        else if(!melody_busy())
+        {
+            score_song(maxStep - 1);    // User step is 1 below maxStep
+            melody_play(scoreSong);
+            state = showEnd;
+        }
+    }
+    else if(state == showEnd)   // Play the last song, then turn the game off
+    {
+        if(skip_pressed())
+        {
+            melody_play(startSong); // Skip to a new game
+            state = showStart;
+        }
+        else if(!melody_busy())
+        {
+            mode = off;
+        }
     }
 }
 
+// Light task. Dim the game LEDs in the dark to make them easier on the eyes
+// and save power: the brightness follows the ambient light level from Q1.
+// The power LED stays fully on, so it never keeps the game from dozing.
+
+void light_task(void)
+{
+    pwm_brightness((unsigned char)(adc_sample(lightSensor) >> lightShift) + lightMin);
+}
+
+// Task table. Tasks run in order once their period (in 1 ms ticks) elapses.
+
+task_t tasks[] =
+{
+    {buttons_scan, 1, 0},       // Button scanner, every tick
+    {melody_task, 1, 0},        // Song player, every tick
+    {simon_task, 1, 0},         // Game state machine, every tick
+    {light_task, 100, 0}        // LED brightness, every 100 ms
+};
+
 int main(void)
 {
     OSC_config();               // Configure internal oscillator for 48 MHz
     UBMP4_config();             // Configure on-board UBMP4 I/O devices
+    ADC_config();               // Configure ADC and start scanning sensors
+    adc_scan_oversample(sensorBits);
+    adc_scan_start(sensors, sizeof(sensors));
+    tone_config();              // Configure Timer1 tone generator
+    load_stats();               // Restore saved stats and random numbers
+    tick_config();              // Configure Timer2 1 ms system tick
+    pwm_config();               // Set up LED PWM (LEDs off, full brightness)
+    ei();                       // Enable interrupts
     
-    LED1 = 0;                   // Power up beep
-    note_E6(50);
+    pwm_set(PWM_D1, PWM_LEVELS);    // Power up beep
+    play_note(NOTE_E6, 19);
     __delay_ms(100);
 
 //    // Button, LED, and sound test code (comment this out later)
@@ -275,6 +742,7 @@ int main(void)
 //		button = get_button();  // Read button code
 //		LED(button);            // Turn on button LED
 //        sound(button);          // Play button sound
+//        while(tone_busy());
 //		LED(0);                 // Turn off button LED
 //
 //        // Activate bootloader if SW1 is pressed.
@@ -286,87 +754,7 @@ int main(void)
     
     while(1)
     {
-        while(mode == off)
-        {
-            LED(0);                 // Turn all game LEDs off
-            nap();                  // Sleep and wait for a button press
-
-            LED1 = 0;               // Turn power LED on and start game
-            game_start();
-            while(SW2 == pressed || SW3 == pressed || SW4 == pressed || SW5 == pressed);
-
-            // Add code to switch to different game modes here
-            
-            // Initialize the random number generator
-            randomSeed = TMR0;      // Generate random number from timer
-            newSeed = (newSeed << 8 ) | randomSeed; // Mix previous seed with random sample
-            srand(newSeed);         // Seed random number generator
-
-            maxStep = 0;            // Clear step count, start simon game mode
-            mode = simon;
-        }
-
-        while(mode == simon)        // Loop until win, lose, or shutdown
-        {
-            // Delay for each turn before picking the next random pattern step
-            __delay_ms(1000);
-            pattern[maxStep] = (rand() & 0b00000011) + 1;
-            maxStep++;              // Increase step count, check for win
-            if(maxStep == (patternLength + 1))
-            {
-                game_win();
-                mode = off;
-            }
-
-            // Play all of the steps in the new pattern
-            for(step = 0; step != maxStep; step++)
-            {
-                LED(pattern[step]);
-                sound(pattern[step]);
-                LED(0);
-                __delay_ms(500);
-            }
-
-            // Let the user try to match the pattern
-            step = 0;               // Reset the step count
-            while(step != maxStep && mode == simon)
-            {
-                idle = 0;               // Reset idle timer for each user guess
-                button = get_button();  // Is a button pressed?
-                while(button == 0 && mode == simon)  // No, Wait for button press
-                {
-                    __delay_ms(50);
-                    button = get_button();
-                    idle++;         // Increment idle timer and check for shutdown
-                    if(idle == timeOut)
-                    {
-                        mode = off;
-                    }
-                }
-                LED(button);        // Show button and play sound for each guess
-                sound(button);
-                LED(0);
-
-                if(button != pattern[step] && mode == simon)
-                {
-                    __delay_ms(500);
-                    game_lose();    // Uh, oh. Button didn't match pattern
-                    mode = off;
-                }
-
-                step++;             // Pattern matched! Go on to the next step
-                idle = 0;           // Reset idle timer while waiting for key release
-                while(get_button() != 0 && mode == simon)
-                {
-                    __delay_ms(50);
-                    idle++;          // Increment idle timer and check for shutdown
-                    if(idle == timeOut)
-                    {
-                        mode = off;
-                    }
-                }
-            }
-        }
+        tick_run(tasks, sizeof(tasks) / sizeof(tasks[0]));
+        doze();                 // Sleep if there's nothing to do for a while
     }
 }
-
@@ -0,0 +1,136 @@
+/*==============================================================================
+ File: UBMP420-adc.c
+ Date: October 16, 2026
+
+ UBMP4.2 (PIC16F1459) interrupt-driven A-D converter scan engine
+
+ adcResult[adcFront] holds the samples of the last complete scan and is only
+ read by the program. The interrupt writes the other set, then swaps by
+ changing adcFront, so reading a sample never needs interrupts disabled - the
+ set being read is not written to again until a whole conversion period
+ after the next swap.
+
+ Oversampling adds each conversion to a per-channel sum in adcSum[]. On the
+ last pass of a scan the sum is decimated (shifted right by adcBits) straight
+ into the back set, so the interrupt does the same small, fixed amount of
+ work for every conversion. 16 10-bit samples sum to at most 16368, so the
+ sums fit in 16 bits.
+==============================================================================*/
+
+#include    "xc.h"              // XC compiler general include file
+
+#include    "stdint.h"          // Include integer definitions
+#include    "stdbool.h"         // Include Boolean (true/false) definitions
+
+#include    "UBMP420.h"         // Include UBMP4.2 constant & function definitions
+#include    "UBMP420-adc.h"     // Include ADC scan engine definitions
+
+// Scan engine variables (shared with the interrupt)
+const unsigned char *adcList;   // Channel list being scanned
+unsigned char adcCount = 0;     // Channels in the list
+unsigned char adcIndex;         // List entry being converted
+uint16_t adcResult[2][ADC_SCAN_MAX];        // Two sets of samples
+volatile unsigned char adcFront = 0;    // Set the program reads (0 or 1)
+volatile unsigned char adcScans = 0;    // Complete scans (wraps)
+uint16_t adcSum[ADC_SCAN_MAX];      // Oversampling sums of this scan
+unsigned char adcBits = 0;      // Extra result bits from oversampling
+unsigned char adcPasses = 1;    // Conversions per channel per scan (4^adcBits)
+unsigned char adcPass;          // Pass through the list being converted
+unsigned char adcCon1;          // ADCON1 before the scan, for ADC_read()
+
+// Set the number of extra result bits (0 to ADC_OVERSAMPLE_MAX).
+void adc_scan_oversample(unsigned char bits)
+{
+    if(bits > ADC_OVERSAMPLE_MAX)
+    {
+        bits = ADC_OVERSAMPLE_MAX;
+    }
+    adcBits = bits;
+    adcPasses = (unsigned char)(1 << (bits * 2));
+}
+
+// Start scanning a list of ADC channels in the background.
+void adc_scan_start(const unsigned char *channels, unsigned char count)
+{
+    unsigned char i;
+
+    if(!ADIE)                   // Not scanning? Keep ADC_read()'s settings
+    {
+        adcCon1 = ADCON1;
+    }
+    ADIE = 0;                   // Stop any scan that is running
+    adcList = channels;
+    adcCount = count;
+    adcIndex = 0;
+    adcPass = 0;
+    for(i = 0; i != count; i++)
+    {
+        adcSum[i] = 0;
+    }
+
+    FVRCON = FVRCON | 0b00100000;   // Turn on temperature indicator (TSEN)
+    ADCON1 = 0b11100000;        // Right justified result, FOSC/64 clock, +VDD ref
+    ADCON0 = channels[0] | 0b00000001;  // Select first channel, turn ADC on
+    ADCON2 = 0b00110000;        // Start conversions on Timer0 overflow
+    ADIF = 0;                   // Clear ADC interrupt flag
+    ADIE = 1;                   // Enable ADC interrupt
+    PEIE = 1;                   // Enable peripheral interrupts
+}
+
+// Stop scanning and turn the ADC off.
+void adc_scan_stop(void)
+{
+    ADIE = 0;
+    ADCON2 = 0b00000000;        // Auto-conversion trigger disabled
+    ADCON0 = 0b00000000;        // Turn the A-D converter off
+    ADCON1 = adcCon1;           // Restore ADC_read()'s left justified result
+    ADIF = 0;
+    FVRCON = FVRCON & 0b11011111;   // Turn temperature indicator off
+}
+
+// Return the number of channels being scanned (0 = stopped).
+unsigned char adc_scan_channels(void)
+{
+    return(ADIE ? adcCount : 0);
+}
+
+// Return the number of complete scans.
+unsigned char adc_scan_count(void)
+{
+    return(adcScans);
+}
+
+// Return the latest sample of a scan list entry.
+uint16_t adc_sample(unsigned char index)
+{
+    return(adcResult[adcFront][index]);
+}
+
+// ADC interrupt service function. Call from the interrupt function.
+void adc_isr(void)
+{
+    uint16_t sum;
+
+    ADIF = 0;                   // Clear ADC interrupt flag
+    sum = adcSum[adcIndex] + ADRES; // Add to this channel's sum
+    if(adcPass == adcPasses - 1)    // Last pass? Decimate into the back set
+    {
+        adcResult[adcFront ^ 1][adcIndex] = sum >> adcBits;
+        sum = 0;
+    }
+    adcSum[adcIndex] = sum;
+    adcIndex++;
+    if(adcIndex == adcCount)    // End of the list? Start the next pass
+    {
+        adcIndex = 0;
+        adcPass++;
+        if(adcPass == adcPasses)    // Scan complete? Swap sets
+        {
+            adcPass = 0;
+            adcFront = adcFront ^ 1;
+            adcScans++;
+        }
+    }
+    // Select the next channel. It settles until the next Timer0 overflow.
+    ADCON0 = adcList[adcIndex] | 0b00000001;
+}
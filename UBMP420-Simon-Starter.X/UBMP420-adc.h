@@ -0,0 +1,102 @@
+/*==============================================================================
+ File: UBMP420-adc.h
+ Date: October 16, 2026
+
+ UBMP4.2 (PIC16F1459) interrupt-driven A-D converter scan engine definitions
+
+ The scan engine converts a list of ADC channels over and over in the
+ background. Each Timer0 overflow starts a conversion through the ADC
+ auto-conversion trigger (once every 5.46 ms with the 1:256 Timer0 prescaler
+ set by UBMP4_config()), and the ADC interrupt stores the 10-bit result and
+ selects the next channel, which then has until the next overflow to settle.
+ The processor never waits for a conversion.
+
+ Results are double-buffered: the interrupt fills one set while the program
+ reads the other, and the two sets are swapped after each complete scan of
+ the list, so all of the samples a program reads come from the same scan.
+
+ Oversampling trades scan rate for resolution. With adc_scan_oversample(n)
+ each channel is converted 4^n times per scan and the samples are summed and
+ decimated to a (10 + n)-bit result, e.g. n = 2 gives 12-bit results from 16
+ conversions. Conversion noise of about 1 LSB (always present, from the
+ sensors and the converter) dithers the extra bits. A scan then takes
+ 4^n * channels * 5.46 ms, and the interrupt cost per conversion stays the
+ same.
+
+ The program's interrupt function must call adc_isr() when ADIF is set. The
+ blocking ADC_read() functions in UBMP420.c must not be used while the scan
+ engine is running.
+==============================================================================*/
+
+#define ADC_SCAN_MAX    6           // Most channels in a scan list
+#define ADC_OVERSAMPLE_MAX  2       // Most extra bits (12-bit results)
+
+/**
+ * Function: void adc_scan_oversample(unsigned char bits)
+ *
+ * Set the number of extra result bits (0 to ADC_OVERSAMPLE_MAX) to get by
+ * oversampling. Each channel is converted 4^bits times per scan. Takes effect
+ * at the next adc_scan_start() and stays set (default 0, 10-bit results).
+ *
+ * Example usage: adc_scan_oversample(2);     // 12-bit results
+ */
+void adc_scan_oversample(unsigned char);
+
+/**
+ * Function: void adc_scan_start(const unsigned char *channels, unsigned char count)
+ *
+ * Start scanning count (1 to ADC_SCAN_MAX) channels from the channels list,
+ * using the channel constants defined in UBMP420.h (e.g. ANQ1, ANTIM). Sets up
+ * ADCON0-ADCON2 for right-justified results and turns on the temperature indicator
+ * for ANTIM. Analog pins must already be set up (e.g. by ADC_config()).
+ *
+ * Example usage: const unsigned char sensors[] = {ANQ1, ANTIM};
+ *                adc_scan_start(sensors, 2);
+ */
+void adc_scan_start(const unsigned char *, unsigned char);
+
+/**
+ * Function: void adc_scan_stop(void)
+ *
+ * Stop scanning and turn off the ADC and temperature indicator (e.g. before
+ * a long sleep), and restore the ADCON1 settings from before the scan so
+ * ADC_read() works again. Results of the last complete scan can still be
+ * read.
+ */
+void adc_scan_stop(void);
+
+/**
+ * Function: unsigned char adc_scan_channels(void)
+ *
+ * Return the number of channels being scanned (0 = scan engine stopped).
+ */
+unsigned char adc_scan_channels(void);
+
+/**
+ * Function: unsigned char adc_scan_count(void)
+ *
+ * Return the number of complete scans so far (wraps from 255 to 0). Compare
+ * with an earlier value to find out whether new samples are available.
+ */
+unsigned char adc_scan_count(void);
+
+/**
+ * Function: uint16_t adc_sample(unsigned char index)
+ *
+ * Return the latest sample of channel number index in the scan list (0 =
+ * first channel), without waiting. Samples are 10-bit (0-1023) plus the
+ * oversampling bits, e.g. 12-bit (0-4092) with adc_scan_oversample(2).
+ *
+ * Example usage: light = adc_sample(0);
+ */
+uint16_t adc_sample(unsigned char);
+
+/**
+ * Function: void adc_isr(void)
+ *
+ * ADC interrupt service function. Adds the result to the channel's sum (or
+ * stores the decimated sum on the last pass) and selects the next channel.
+ *
+ * Example usage: if(ADIF == 1 && ADIE == 1) adc_isr();
+ */
+void adc_isr(void);
@@ -0,0 +1,111 @@
+/*==============================================================================
+ File: UBMP420-buttons.c
+ Date: October 16, 2026
+
+ UBMP4.2 (PIC16F1459) debounced pushbutton scanner
+
+ Each switch has a 2-bit counter, stored 'vertically' as bit n of count0 and
+ count1, so one set of byte operations counts all four switches in parallel.
+ A counter is reset whenever its switch reads the same as its debounced
+ state, and the state toggles when the counter rolls over after
+ BUTTON_DEBOUNCE (4) differing reads in a row.
+==============================================================================*/
+
+#include    "xc.h"              // XC compiler general include file
+
+#include    "stdint.h"          // Include integer definitions
+#include    "stdbool.h"         // Include Boolean (true/false) definitions
+
+#include    "UBMP420.h"         // Include UBMP4.2 constant & function definitions
+#include    "UBMP420-tick.h"    // Include system tick definitions
+#include    "UBMP420-buttons.h" // Include button scanner definitions
+
+// Debounce state (one bit per switch in the BUTTON_PINS positions, 1 = pressed)
+unsigned char buttonState = 0;  // Debounced switch states
+unsigned char buttonCount0 = 0xFF;  // Vertical counter bit 0
+unsigned char buttonCount1 = 0xFF;  // Vertical counter bit 1
+
+// Event queue. Only written by buttons_scan() and read by buttons_get_event(),
+// both from the main program, so it needs no interrupt protection.
+button_event_t buttonQueue[BUTTON_QUEUE];
+unsigned char buttonHead = 0;   // Next event to write
+unsigned char buttonTail = 0;   // Next event to read
+
+// Add an event to the queue. Events are dropped if the queue is full.
+static void buttons_queue(unsigned char button, bool press, uint16_t time)
+{
+    unsigned char next = (buttonHead + 1) & (BUTTON_QUEUE - 1);
+
+    if(next != buttonTail)
+    {
+        buttonQueue[buttonHead].button = button;
+        buttonQueue[buttonHead].press = press;
+        buttonQueue[buttonHead].time = time;
+        buttonHead = next;
+    }
+}
+
+// Read and debounce SW2-SW5, and queue an event for each debounced change.
+void buttons_scan(void)
+{
+    unsigned char changed;
+    unsigned char mask;
+    unsigned char button;
+    uint16_t time;
+
+    changed = buttonState ^ (~PORTB & BUTTON_PINS); // Read all switches at once
+    buttonCount0 = ~(buttonCount0 & changed);   // Count changed switches,
+    buttonCount1 = buttonCount0 ^ (buttonCount1 & changed); // reset the rest
+    changed &= buttonCount0 & buttonCount1;     // Counted 4 in a row?
+    if(changed == 0)
+    {
+        return;
+    }
+    buttonState ^= changed;     // Switch to the new debounced states
+
+    time = tick_ms();
+    mask = 0b00010000;          // Queue events in SW2-SW5 order
+    for(button = 1; button != 5; button++)
+    {
+        if(changed & mask)
+        {
+            buttons_queue(button, (buttonState & mask) != 0, time);
+            tick_idle_reset();  // Any button activity restarts idle time-out
+        }
+        mask = mask << 1;
+    }
+}
+
+// Remove the oldest queued event. Returns false if there are no events.
+bool buttons_get_event(button_event_t *event)
+{
+    if(buttonTail == buttonHead)
+    {
+        return(false);
+    }
+    *event = buttonQueue[buttonTail];
+    buttonTail = (buttonTail + 1) & (BUTTON_QUEUE - 1);
+    return(true);
+}
+
+// Return debounced SW2-SW5 states (bit 0 = SW2).
+unsigned char buttons_held(void)
+{
+    return(buttonState >> 4);
+}
+
+// Return true if no events are queued and all buttons are released.
+bool buttons_idle(void)
+{
+    return(buttonTail == buttonHead && buttonState == 0 &&
+           (PORTB & BUTTON_PINS) == BUTTON_PINS);
+}
+
+// Discard queued events and accept the current switch levels as debounced.
+void buttons_flush(void)
+{
+    buttonState = ~PORTB & BUTTON_PINS;
+    buttonCount0 = 0xFF;
+    buttonCount1 = 0xFF;
+    buttonTail = buttonHead;
+}
@@ -0,0 +1,71 @@
+/*==============================================================================
+ File: UBMP420-buttons.h
+ Date: October 16, 2026
+
+ UBMP4.2 (PIC16F1459) debounced pushbutton scanner definitions
+
+ buttons_scan() reads SW2-SW5 from PORTB in a single read and debounces all
+ four switches at once with a 2-bit vertical counter: a switch changes state
+ after it reads the same new level on BUTTON_DEBOUNCE consecutive scans.
+ Each debounced change is queued as a press or release event stamped with
+ the tick_ms() time, so short taps are never missed and bounces are never
+ counted twice, even when the program is busy for a while between reads.
+
+ Run buttons_scan() every tick from the task scheduler (UBMP420-tick.h).
+==============================================================================*/
+
+// Button scanner settings
+#define BUTTON_PINS     0b11110000  // SW2-SW5 pins in PORTB (active-low)
+#define BUTTON_DEBOUNCE 4           // Stable scans to change state (2-bit counter)
+#define BUTTON_QUEUE    8           // Event queue size (power of 2)
+
+// Button event. Button codes match get_button(): 1 = SW2, 2 = SW3, etc.
+typedef struct
+{
+    unsigned char button;           // Button code (1-4)
+    bool press;                     // true = press, false = release
+    uint16_t time;                  // tick_ms() time of the debounced change
+} button_event_t;
+
+/**
+ * Function: void buttons_scan(void)
+ *
+ * Read and debounce SW2-SW5 and queue an event for each debounced change.
+ * Call once every tick (scheduler task with a period of 1).
+ */
+void buttons_scan(void);
+
+/**
+ * Function: bool buttons_get_event(button_event_t *event)
+ *
+ * Remove the oldest event from the queue and copy it to event. Returns false
+ * (and leaves event unchanged) if the queue is empty.
+ *
+ * Example usage: while(buttons_get_event(&event)) { ... }
+ */
+bool buttons_get_event(button_event_t *);
+
+/**
+ * Function: unsigned char buttons_held(void)
+ *
+ * Return the debounced state of SW2-SW5 as a bit mask (bit 0 = SW2, bit 1 =
+ * SW3, etc.). 0 = no buttons held down.
+ */
+unsigned char buttons_held(void);
+
+/**
+ * Function: bool buttons_idle(void)
+ *
+ * Return true if no events are queued and SW2-SW5 are all released, so the
+ * next button activity will start with a press (and an IOC interrupt).
+ */
+bool buttons_idle(void);
+
+/**
+ * Function: void buttons_flush(void)
+ *
+ * Discard all queued events and take the current switch levels as the
+ * debounced state, so buttons already held down do not cause a press event.
+ * Use before waiting for a new button press, e.g. after waking from sleep.
+ */
+void buttons_flush(void);
@@ -0,0 +1,103 @@
+/*==============================================================================
+ File: UBMP420-melody.c
+ Date: October 16, 2026
+
+ UBMP4.2 (PIC16F1459) melody and light sequencer
+==============================================================================*/
+
+#include    "xc.h"              // XC compiler general include file
+
+#include    "stdint.h"          // Include integer definitions
+#include    "stdbool.h"         // Include Boolean (true/false) definitions
+
+#include    "UBMP420.h"         // Include UBMP4.2 constant & function definitions
+#include    "UBMP420-tone.h"    // Include tone generator definitions
+#include    "UBMP420-tick.h"    // Include system tick definitions
+#include    "UBMP420-pwm.h"     // Include software PWM definitions
+#include    "UBMP420-melody.h"  // Include melody sequencer definitions
+
+// Sequencer variables
+const melody_event_t *melodySong;   // Song being played
+unsigned char melodyIndex;      // Event being played
+uint16_t melodyTime;            // Tick time (ms) the event started
+uint16_t melodyMs;              // Duration of the event being played
+uint16_t melodyRepeats;         // Repeats left at the current repeat event
+bool melodyRepeating = false;   // Repeat event reached, melodyRepeats counting
+bool melodyPlaying = false;     // True while a song is playing
+
+// Start the next sounding event, going through any repeat events first.
+static void melody_next(void)
+{
+    const melody_event_t *event = &melodySong[melodyIndex];
+
+    while(event->note == MELODY_REPEAT)
+    {
+        if(!melodyRepeating)    // First time here: load the repeat count
+        {
+            melodyRepeats = event->ms;
+            melodyRepeating = true;
+        }
+        if(melodyRepeats != 0)  // Go back and play the events again
+        {
+            melodyRepeats--;
+            melodyIndex = melodyIndex - event->leds;
+        }
+        else
+        {
+            melodyRepeating = false;
+            melodyIndex++;
+        }
+        event = &melodySong[melodyIndex];
+    }
+
+    pwm_leds(event->leds);
+    if(event->ms == 0)          // End of the song
+    {
+        melodyPlaying = false;
+        return;
+    }
+    if(event->note == MELODY_REST)
+    {
+        tone_stop();
+    }
+    else
+    {
+        tone_note(event->note, event->ms);
+    }
+    melodyMs = event->ms;
+    melodyIndex++;
+}
+
+// Start playing a song and return immediately.
+void melody_play(const melody_event_t *song)
+{
+    melodySong = song;
+    melodyIndex = 0;
+    melodyRepeating = false;
+    melodyPlaying = true;
+    melodyTime = tick_ms();
+    melody_next();
+}
+
+// Stop the song that is playing.
+void melody_stop(void)
+{
+    melodyPlaying = false;
+}
+
+// Return true while a song is playing.
+bool melody_busy(void)
+{
+    return(melodyPlaying);
+}
+
+// Start the next event when the current one is over. Call every tick.
+void melody_task(void)
+{
+    if(!melodyPlaying || (uint16_t)(tick_ms() - melodyTime) < melodyMs)
+    {
+        return;
+    }
+    melodyTime = melodyTime + melodyMs; // Next event starts on time
+    melody_next();
+}
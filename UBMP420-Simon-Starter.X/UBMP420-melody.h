@@ -0,0 +1,79 @@
+/*==============================================================================
+ File: UBMP420-melody.h
+ Date: October 16, 2026
+
+ UBMP4.2 (PIC16F1459) melody and light sequencer definitions
+
+ A song is an array of events, normally const so that it is stored in
+ program memory. Each event plays a note (or a rest) for a number of ms and
+ lights a pattern of the game LEDs at the same time, so sound and light
+ effects are written as data instead of code:
+
+     const melody_event_t winSong[] =
+     {
+         {NOTE_E6, PWM_LEDS, 190},
+         {MELODY_REST, PWM_LEDS, 200},
+         {NOTE_E6, PWM_LEDS, 303},
+         MELODY_END(0)
+     };
+
+ A repeat event plays the events before it again, e.g. to flash an LED a
+ number of times worked out when the song is built in RAM. Repeats can't be
+ nested.
+
+ melody_play() starts a song and returns at once. melody_task() steps
+ through the song from the task scheduler, starting each note on the tone
+ generator and changing the LEDs through the PWM engine, so the processor
+ is free while a song plays. Event times are counted from the start of the
+ song, so they don't drift even if the task runs late.
+
+ Run melody_task() every tick from the task scheduler (UBMP420-tick.h).
+==============================================================================*/
+
+#define MELODY_REST     0           // Note number of a rest (silence)
+#define MELODY_REPEAT   0xFF        // Note number of a repeat event
+
+// Song event. A repeat event uses leds for the number of events to go back
+// and ms for the number of times to play them again.
+typedef struct
+{
+    unsigned char note;             // Note (e.g. NOTE_A5), MELODY_REST or MELODY_REPEAT
+    unsigned char leds;             // Game LEDs lit (PWM_LED2-PWM_LED5 bits)
+    uint16_t ms;                    // Duration (ms), 0 = end of song
+} melody_event_t;
+
+#define MELODY_END(leds)    {MELODY_REST, (leds), 0}    // End, leaving leds lit
+#define MELODY_AGAIN(events, times) {MELODY_REPEAT, (events), (times)}
+
+/**
+ * Function: void melody_play(const melody_event_t *song)
+ *
+ * Start playing a song from its first event and return immediately. A new
+ * song replaces any song already playing.
+ *
+ * Example usage: melody_play(winSong);
+ */
+void melody_play(const melody_event_t *);
+
+/**
+ * Function: void melody_stop(void)
+ *
+ * Stop the song that is playing, leaving the tone generator and LEDs as they
+ * are.
+ */
+void melody_stop(void);
+
+/**
+ * Function: bool melody_busy(void)
+ *
+ * Return true while a song is playing.
+ */
+bool melody_busy(void);
+
+/**
+ * Function: void melody_task(void)
+ *
+ * Start the next event of the song when the current one has lasted its
+ * duration. Call once every tick (scheduler task with a period of 1).
+ */
+void melody_task(void);
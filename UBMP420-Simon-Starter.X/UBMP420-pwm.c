@@ -0,0 +1,208 @@
+/*==============================================================================
+ File: UBMP420-pwm.c
+ Date: October 16, 2026
+
+ UBMP4.2 (PIC16F1459) software PWM LED dimmer
+
+ pwmTable[pwmFront] holds the PWM waveform of every LED for each of the
+ PWM_LEVELS steps of a PWM cycle: bits 4-7 are the LATC bits of D2-D5 and
+ bit 0 is D1 (1 = on). The outputs of a step are its table entry ANDed with
+ pwmOn, the LEDs that are lit, so turning LEDs on and off only changes
+ pwmOn. The table is only rebuilt when a duty cycle or the brightness
+ changes: pwm_update() builds the new table in the other set and then swaps
+ sets, like the ADC scan engine, so the interrupt never reads a half-built
+ table unless two updates follow each other within one step.
+
+ The Timer2 rate only changes in the interrupt, right after a tick, and
+ writing T2CON clears the postscaler, so the tick period stays exact across
+ a change.
+==============================================================================*/
+
+#include    "xc.h"              // XC compiler general include file
+
+#include    "stdint.h"          // Include integer definitions
+#include    "stdbool.h"         // Include Boolean (true/false) definitions
+
+#include    "UBMP420.h"         // Include UBMP4.2 constant & function definitions
+#include    "UBMP420-tick.h"    // Include system tick definitions
+#include    "UBMP420-pwm.h"     // Include software PWM definitions
+
+#define PWM_CHANNELS    5       // LEDs driven by the PWM engine
+
+// LED bit of each PWM channel in pwmTable entries
+const unsigned char pwmBits[PWM_CHANNELS] = {PWM_D1, PWM_LED2, PWM_LED3, PWM_LED4, PWM_LED5};
+
+// PWM variables (shared with the interrupt)
+unsigned char pwmDuty[PWM_CHANNELS];    // Duty cycle of each LED (1-16)
+unsigned char pwmBright = PWM_LEVELS;   // Master brightness (0-16)
+unsigned char pwmTable[2][PWM_LEVELS];  // Two sets of LED waveforms per step
+unsigned char pwmDimmed = 0;    // LEDs with a waveform that is not all on/off
+volatile unsigned char pwmOn = 0;   // LEDs that are lit (PWM_ bits)
+volatile unsigned char pwmFront = 0;    // Set the interrupt reads (0 or 1)
+volatile bool pwmRun = false;   // Some lit LED is dimmed, PWM steps needed
+volatile bool pwmFast = false;  // Timer2 is running at the PWM step rate
+unsigned char pwmPhase = 0;     // PWM step being output
+unsigned char pwmStep = 0;      // PWM steps into the current tick
+
+// Write the lit LEDs to the outputs, or start or stop the PWM steps.
+static void pwm_output(void)
+{
+    unsigned char out;
+
+    pwmRun = (pwmOn & pwmDimmed) != 0;
+    if(!pwmFast)                // No PWM steps yet? Write the LEDs now
+    {
+        out = pwmTable[pwmFront][0] & pwmOn;
+        LATC = (LATC & 0b00001111) | (out & PWM_LEDS);  // One masked store
+        LED1 = (out & PWM_D1) ? 0 : 1;
+    }
+}
+
+// Build the waveforms of all LEDs from their duty cycles and the brightness.
+static void pwm_update(void)
+{
+    unsigned char back = pwmFront ^ 1;
+    unsigned char ch;
+    unsigned char i;
+    unsigned char on;
+    unsigned char bright;
+    unsigned char dimmed = 0;
+
+    for(i = 0; i != PWM_LEVELS; i++)
+    {
+        pwmTable[back][i] = 0;
+    }
+    for(ch = 0; ch != PWM_CHANNELS; ch++)
+    {
+        // Steps on = duty * brightness / 16, rounded up. The brightness
+        // doesn't dim D1, so the power LED alone never keeps the PWM engine
+        // (and the processor) running
+        bright = (pwmBits[ch] == PWM_D1) ? PWM_LEVELS : pwmBright;
+        on = (unsigned char)(((uint16_t)pwmDuty[ch] * bright + PWM_LEVELS - 1) / PWM_LEVELS);
+        if(on != 0 && on != PWM_LEVELS)
+        {
+            dimmed |= pwmBits[ch];
+        }
+        for(i = 0; i != on; i++)
+        {
+            pwmTable[back][i] |= pwmBits[ch];   // LED on for the first steps
+        }
+    }
+    pwmFront = back;
+    pwmDimmed = dimmed;
+    pwm_output();
+}
+
+// Set all LEDs to full duty cycle, off, and build their waveforms.
+void pwm_config(void)
+{
+    unsigned char ch;
+
+    for(ch = 0; ch != PWM_CHANNELS; ch++)
+    {
+        pwmDuty[ch] = PWM_LEVELS;
+    }
+    pwmOn = 0;
+    pwm_update();
+}
+
+// Set the duty cycle (0-16) of each LED in leds. 0 turns the LEDs off.
+void pwm_set(unsigned char leds, unsigned char duty)
+{
+    unsigned char ch;
+    bool changed = false;
+
+    if(duty == 0)
+    {
+        pwmOn = pwmOn & ~leds;  // Off: keep the waveforms for next time
+        pwm_output();
+        return;
+    }
+    if(duty > PWM_LEVELS)
+    {
+        duty = PWM_LEVELS;
+    }
+    for(ch = 0; ch != PWM_CHANNELS; ch++)
+    {
+        if((leds & pwmBits[ch]) && pwmDuty[ch] != duty)
+        {
+            pwmDuty[ch] = duty;
+            changed = true;
+        }
+    }
+    pwmOn = pwmOn | leds;
+    if(changed)
+    {
+        pwm_update();           // New waveforms
+    }
+    else
+    {
+        pwm_output();
+    }
+}
+
+// Light exactly the game LEDs in leds, at their duty cycles.
+void pwm_leds(unsigned char leds)
+{
+    pwmOn = (pwmOn & ~PWM_LEDS) | (leds & PWM_LEDS);
+    pwm_output();
+}
+
+// Set the master brightness (0-16) of all LEDs.
+void pwm_brightness(unsigned char level)
+{
+    if(level > PWM_LEVELS)
+    {
+        level = PWM_LEVELS;
+    }
+    if(level != pwmBright)
+    {
+        pwmBright = level;
+        pwm_update();
+    }
+}
+
+// Return true while the PWM engine is running.
+bool pwm_busy(void)
+{
+    return(pwmRun || pwmFast);
+}
+
+// Timer2 interrupt service function. Call from the interrupt function, and
+// call tick_isr() if it returns true.
+bool pwm_isr(void)
+{
+    unsigned char out;
+
+    TMR2IF = 0;                 // Clear Timer2 interrupt flag
+    if(pwmFast)                 // Output the next PWM step
+    {
+        out = pwmTable[pwmFront][pwmPhase] & pwmOn;
+        LATC = (LATC & 0b00001111) | (out & PWM_LEDS);
+        LED1 = (out & PWM_D1) ? 0 : 1;
+        pwmPhase = (pwmPhase + 1) & (PWM_LEVELS - 1);
+        pwmStep++;
+        if(pwmStep != PWM_TICK_STEPS)
+        {
+            return(false);      // Not a tick yet
+        }
+        pwmStep = 0;
+    }
+    if(pwmRun != pwmFast)       // Start or stop the PWM steps at this tick
+    {
+        pwmFast = pwmRun;
+        pwmPhase = 0;
+        if(pwmFast)
+        {
+            T2CON = PWM_T2CON;  // Interrupt at the PWM step rate
+        }
+        else
+        {
+            T2CON = TICK_T2CON; // Back to 1 ms ticks and fixed LED outputs
+            out = pwmTable[pwmFront][0] & pwmOn;
+            LATC = (LATC & 0b00001111) | (out & PWM_LEDS);
+            LED1 = (out & PWM_D1) ? 0 : 1;
+        }
+    }
+    return(true);
+}
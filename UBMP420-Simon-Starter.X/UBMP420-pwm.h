@@ -0,0 +1,109 @@
+/*==============================================================================
+ File: UBMP420-pwm.h
+ Date: October 16, 2026
+
+ UBMP4.2 (PIC16F1459) software PWM LED dimmer definitions
+
+ The PWM engine dims LEDs D2-D5 and the power LED D1 with a duty cycle of 0
+ to PWM_LEVELS sixteenths for each LED, and scales the game LEDs by a master
+ brightness (e.g. set from the ambient light level). It shares Timer2 with
+ the 1 ms system tick: while any LED is dimmed, Timer2 interrupts every
+ 200 us instead of every 1 ms and pwm_isr() writes the next step of the PWM
+ cycle to the LEDs, for a 312.5 Hz PWM frequency with no visible flicker.
+ Every fifth step is also a tick. When all LEDs are fully on or off, Timer2
+ goes back to 1 ms interrupts and the LEDs are written once.
+
+ pwm_set() and pwm_brightness() pre-compute the waveform of each LED for the
+ 16 steps, so each PWM interrupt is a table read, an AND with the lit LEDs
+ and two port writes. LEDs D2-D5 are in LATC4-LATC7 and the PWM_ LED bits
+ match their LATC bits, so turning LEDs on or off (one LED, or any chord of
+ them with pwm_leds()) is a single byte update and, when no LEDs are dimmed,
+ a single masked store to LATC. The tone interrupt is checked first in the
+ interrupt function, and Timer1 reloads count the time since the overflow,
+ so a PWM step can only delay a beeper edge by a few us - never change the
+ pitch.
+
+ While the PWM engine is running the processor must stay awake, as Timer2
+ stops in sleep (see pwm_busy()). Only use pwm_set() to change the LEDs it
+ drives - writes to LED1-LED5 would be overwritten by the next PWM step.
+
+ The program's interrupt function must call pwm_isr() when TMR2IF is set,
+ and call tick_isr() whenever it returns true.
+==============================================================================*/
+
+// Timer2 settings for PWM steps: same as the tick, with a 1:1 postscaler
+#define PWM_T2CON   0b00000110      // 1:1 postscaler, Timer2 on, 1:16 prescaler
+#define PWM_TICK_STEPS  5           // PWM steps per 1 ms tick
+
+#define PWM_LEVELS  16              // Duty cycle and brightness steps (full on)
+
+// LEDs driven by the PWM engine (bit masks that can be ORed together)
+#define PWM_D1      0b00000001      // Power LED D1 (LATA5, active-low)
+#define PWM_LED2    0b00010000      // LED D2 (LATC4)
+#define PWM_LED3    0b00100000      // LED D3 (LATC5)
+#define PWM_LED4    0b01000000      // LED D4 (LATC6)
+#define PWM_LED5    0b10000000      // LED D5 (LATC7)
+#define PWM_LEDS    0b11110000      // Game LEDs D2-D5
+
+/**
+ * Function: void pwm_config(void)
+ *
+ * Turn all PWM LEDs off and set their duty cycles to PWM_LEVELS (full on).
+ * Call once before the other PWM functions.
+ */
+void pwm_config(void);
+
+/**
+ * Function: void pwm_set(unsigned char leds, unsigned char duty)
+ *
+ * Light each LED in leds (PWM_ constants ORed together) with a duty cycle
+ * from 1 to PWM_LEVELS (full on), before scaling by the master brightness,
+ * or turn them off with a duty cycle of 0. Other LEDs are not changed. The
+ * LEDs change right away (or within one 3.2 ms PWM cycle). Changing a duty
+ * cycle rebuilds the PWM table (hundreds of cycles); turning LEDs on at
+ * their last duty cycle, or off, only takes a few.
+ *
+ * Example usage: pwm_set(PWM_LED2 | PWM_LED3, PWM_LEVELS);
+ */
+void pwm_set(unsigned char, unsigned char);
+
+/**
+ * Function: void pwm_leds(unsigned char leds)
+ *
+ * Light exactly the game LEDs (D2-D5) in leds at their last duty cycles, and
+ * turn the other game LEDs off, all at once. D1 is not changed.
+ *
+ * Example usage: pwm_leds(PWM_LED2 | PWM_LED5);   // Chord of D2 and D5
+ */
+void pwm_leds(unsigned char);
+
+/**
+ * Function: void pwm_brightness(unsigned char level)
+ *
+ * Set the master brightness of game LEDs D2-D5 from 0 (off) to PWM_LEVELS
+ * (full duty cycles). Each LED's on-time is its duty cycle scaled by level,
+ * rounded up so dimmed LEDs that are on never go dark. D1 keeps its own
+ * duty cycle, so a power LED left on doesn't stop the processor sleeping.
+ *
+ * Example usage: pwm_brightness(PWM_LEVELS / 2);
+ */
+void pwm_brightness(unsigned char);
+
+/**
+ * Function: bool pwm_busy(void)
+ *
+ * Return true while the PWM engine is running (some LED is dimmed), when the
+ * processor must not sleep.
+ */
+bool pwm_busy(void);
+
+/**
+ * Function: bool pwm_isr(void)
+ *
+ * Timer2 interrupt service function. Clears TMR2IF, writes the next PWM step
+ * to the LEDs, and switches the Timer2 rate at a tick when the PWM engine
+ * starts or stops. Returns true when a 1 ms tick is due.
+ *
+ * Example usage: if(TMR2IF == 1 && TMR2IE == 1) if(pwm_isr()) tick_isr();
+ */
+bool pwm_isr(void);
@@ -0,0 +1,86 @@
+/*==============================================================================
+ File: UBMP420-random.c
+ Date: October 16, 2026
+
+ UBMP4.2 (PIC16F1459) random number generator
+
+ The generator state is __persistent so it is not cleared by the C start-up
+ code, and a reset (or a new game) continues from where the last one left
+ off instead of starting over from the same value. It is a uint16_t, so
+ host builds, where int is 32 bits, run the same 16-bit sequence as the PIC.
+==============================================================================*/
+
+#include    "xc.h"              // XC compiler general include file
+
+#include    "stdint.h"          // Include integer definitions
+#include    "stdbool.h"         // Include Boolean (true/false) definitions
+
+#include    "UBMP420.h"         // Include UBMP4.2 constant & function definitions
+#include    "UBMP420-adc.h"     // Include ADC scan engine definitions
+#include    "UBMP420-random.h"  // Include random number generator definitions
+
+#define RANDOM_SCANS    2       // New ADC scans mixed in per seeding
+
+__persistent uint16_t randomSeed;   // Generator state (must not be 0)
+unsigned char randomScan;       // ADC scan count when last checked
+unsigned char randomScans = 0;  // ADC scans still to mix in
+
+// Advance the generator and return its new state.
+uint16_t random_next(void)
+{
+    if(randomSeed == 0)         // Power-up garbage can be 0, which would
+    {                           // stick, so replace it
+        randomSeed = 0xACE1;
+    }
+    randomSeed ^= randomSeed << 7;
+    randomSeed ^= randomSeed >> 9;
+    randomSeed ^= randomSeed << 8;
+    return(randomSeed);
+}
+
+// Return a random button code from 1 to 4 from the two top state bits.
+unsigned char random_button(void)
+{
+    return((unsigned char)(random_next() >> 14) + 1);
+}
+
+// Mix saved bits (e.g. a number from a previous power-up) into the generator.
+void random_mix(uint16_t bits)
+{
+    randomSeed ^= bits;
+    random_next();
+}
+
+// Mix TMR0 and the previous state into the generator, and start waiting for
+// new ADC scans to mix in.
+void random_seed(void)
+{
+    randomSeed ^= TMR0;         // Player timing
+    random_next();
+    randomScan = adc_scan_count();
+    randomScans = adc_scan_channels() ? RANDOM_SCANS : 0;   // No ADC scan
+}                                                       // running, no noise
+
+// Mix in the ADC scan finished since the last call, if random_seed() is still
+// waiting for one. Returns true until all of its scans have been mixed in.
+bool random_seeding(void)
+{
+    unsigned char ch;
+
+    if(randomScans == 0 || adc_scan_count() == randomScan)
+    {
+        return(randomScans != 0);
+    }
+    randomScan = adc_scan_count();
+    randomScans--;
+    // Mix in every sample, whose lowest bits are mostly noise (more so when
+    // oversampled, as they sum the noise of every conversion), rotating each
+    // one to a new position, and stir them through the generator
+    for(ch = 0; ch != adc_scan_channels(); ch++)
+    {
+        randomSeed ^= adc_sample(ch) << (ch * 3);
+        randomSeed ^= TMR0;
+        random_next();
+    }
+    return(randomScans != 0);
+}
@@ -0,0 +1,71 @@
+/*==============================================================================
+ File: UBMP420-random.h
+ Date: October 16, 2026
+
+ UBMP4.2 (PIC16F1459) random number generator definitions
+
+ A 16-bit xorshift generator (shifts 7, 9, 8) replaces the XC8 library rand()
+ and srand() functions. Each number takes a few byte moves and three shift/
+ xor passes, and every bit of the result is equally random, so the high
+ bits can be used directly without the bias of masking rand()'s low bits.
+
+ random_seed() mixes new entropy into the generator: the free-running TMR0
+ count (which depends on the player's button timing) and the previous
+ generator state, which is kept in persistent memory so it carries over
+ between games and resets. random_seeding() then adds the noise in the low
+ bits of the next two scans of the ADC scan engine's channels (the game
+ scans the phototransistor Q1 and the on-die temperature indicator) as they
+ finish, so a task can seed the generator without waiting for them.
+ random_mix() adds a number saved from an earlier power-up, so the sequence
+ doesn't restart after the power is turned off.
+==============================================================================*/
+
+/**
+ * Function: void random_seed(void)
+ *
+ * Mix TMR0 and the previous state into the generator, and if the ADC scan
+ * engine is running, start waiting for two new scans to mix in with
+ * random_seeding(). Call when the timing of a player action has made TMR0
+ * unpredictable, e.g. when a button is released.
+ */
+void random_seed(void);
+
+/**
+ * Function: bool random_seeding(void)
+ *
+ * Mix in the ADC scan finished since the last call, if random_seed() is
+ * still waiting for one, and return true until both of its scans have been
+ * mixed in (up to hundreds of ms when oversampling). Doesn't wait, so call
+ * it from a task until it returns false before drawing numbers that need
+ * the new entropy. ADC scans don't progress in sleep.
+ *
+ * Example usage: if(!random_seeding() && stateTimer == 0) pattern_add();
+ */
+bool random_seeding(void);
+
+/**
+ * Function: void random_mix(uint16_t bits)
+ *
+ * Mix bits into the generator state and advance it.
+ *
+ * Example usage: random_mix(savedSeed);
+ */
+void random_mix(uint16_t);
+
+/**
+ * Function: uint16_t random_next(void)
+ *
+ * Advance the generator and return its new 16-bit state (never 0).
+ *
+ * Example usage: patternSeed = random_next();
+ */
+uint16_t random_next(void);
+
+/**
+ * Function: unsigned char random_button(void)
+ *
+ * Return a uniformly distributed random button code from 1 to 4.
+ *
+ * Example usage: step = random_button();
+ */
+unsigned char random_button(void);
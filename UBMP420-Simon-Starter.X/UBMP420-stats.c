@@ -0,0 +1,118 @@
+/*==============================================================================
+ File: UBMP420-stats.c
+ Date: October 16, 2026
+
+ UBMP4.2 (PIC16F1459) game statistics
+
+ tick_ms() wraps every 65.5 s, so a press is timed by subtracting its time
+ stamp from the ready time (which wraps correctly as long as the reaction is
+ shorter than that) and a whole game, which can be much longer, is timed by
+ adding up the time passed to stats_time(). The mean is kept as a sum and a
+ count. If the count would overflow, both are halved, which keeps the mean
+ while giving later games a little more weight.
+==============================================================================*/
+
+#include    "xc.h"              // XC compiler general include file
+
+#include    "stdint.h"          // Include integer definitions
+#include    "stdbool.h"         // Include Boolean (true/false) definitions
+
+#include    "UBMP420.h"         // Include UBMP4.2 constant & function definitions
+#include    "UBMP420-stats.h"   // Include game statistics definitions
+
+stats_t stats = {0, 0, 0, 0, 0, 0xFFFF, 0, 0, 0};
+bool statsPlaying = false;      // A game is being timed
+uint16_t statsReady;            // tick_ms() time the next step became available
+
+// Load the saved game counters.
+void stats_restore(uint16_t games, uint16_t bestScore)
+{
+    stats.games = games;
+    stats.bestScore = bestScore;
+}
+
+// Start timing a new game.
+void stats_game_start(void)
+{
+    stats.lastTime = 0;
+    statsPlaying = true;
+}
+
+// Count a finished game and its score.
+void stats_game_end(uint16_t score)
+{
+    if(!statsPlaying)
+    {
+        return;                 // Already counted
+    }
+    statsPlaying = false;
+    stats.games++;
+    stats.lastScore = score;
+    if(score > stats.bestScore)
+    {
+        stats.bestScore = score;
+    }
+}
+
+// Add to the length of the game being played.
+void stats_time(uint16_t ms)
+{
+    if(statsPlaying)
+    {
+        stats.lastTime += ms;
+    }
+}
+
+// Record when the next step became available.
+void stats_ready(uint16_t time)
+{
+    statsReady = time;
+}
+
+// Time a press against the ready time.
+void stats_press(uint16_t time)
+{
+    uint16_t reaction = time - statsReady;
+
+    if(reaction > 0x7FFF)       // Pressed before the step was ready
+    {
+        reaction = 0;
+    }
+    if(stats.reactions == 0xFFFF)   // Keep the mean if the count would overflow
+    {
+        stats.reactions = stats.reactions >> 1;
+        stats.reactionSum = stats.reactionSum >> 1;
+    }
+    stats.reactions++;
+    stats.reactionSum += reaction;
+    if(reaction < stats.reactionMin)
+    {
+        stats.reactionMin = reaction;
+    }
+    if(reaction > stats.reactionMax)
+    {
+        stats.reactionMax = reaction;
+    }
+}
+
+// Record the time taken to light the first LED after waking.
+void stats_wake(uint16_t ns)
+{
+    stats.wakeTime = ns;
+}
+
+// Return the mean reaction time.
+uint16_t stats_reaction_mean(void)
+{
+    if(stats.reactions == 0)
+    {
+        return(0);
+    }
+    return((uint16_t)(stats.reactionSum / stats.reactions));
+}
+
+// Return the statistics.
+const stats_t *stats_read(void)
+{
+    return(&stats);
+}
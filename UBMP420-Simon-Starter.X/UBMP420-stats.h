@@ -0,0 +1,109 @@
+/*==============================================================================
+ File: UBMP420-stats.h
+ Date: October 16, 2026
+
+ UBMP4.2 (PIC16F1459) game statistics definitions
+
+ Keeps play statistics for tuning game timing: the number of games played,
+ the best score, the score and length of the last game, and the reaction
+ time of every button press - the time from when a step became available to
+ the player (e.g. when the last pattern step finished playing) to the
+ debounced press. Presses made before their step was available (e.g. while
+ the previous guess was still sounding) count as a 0 ms reaction.
+
+ All times come from the free-running tick_ms() count, so the statistics
+ cost a few adds and compares per press and nothing while the game waits.
+ stats_read() returns the statistics for display or to read them out with
+ the debugger or the host simulation.
+==============================================================================*/
+
+// Game statistics. Reaction times are in ms.
+typedef struct
+{
+    uint16_t games;                 // Games played
+    uint16_t bestScore;             // Highest score
+    uint16_t lastScore;             // Score of the last game
+    uint32_t lastTime;              // Length of the last game (ms)
+    uint16_t reactions;             // Presses timed
+    uint16_t reactionMin;           // Fastest reaction (0xFFFF = none yet)
+    uint16_t reactionMax;           // Slowest reaction
+    uint32_t reactionSum;           // Sum of the timed reactions
+    uint16_t wakeTime;              // Last wake-up to power LED on time (ns)
+} stats_t;
+
+/**
+ * Function: void stats_restore(uint16_t games, uint16_t bestScore)
+ *
+ * Load the games played and best score saved before the last power-down.
+ */
+void stats_restore(uint16_t, uint16_t);
+
+/**
+ * Function: void stats_game_start(void)
+ *
+ * Start timing a new game. Call when the first turn of a game begins.
+ */
+void stats_game_start(void);
+
+/**
+ * Function: void stats_game_end(uint16_t score)
+ *
+ * Count a finished game and its score. Only the first call after
+ * stats_game_start() counts, so every path that ends a game can call it.
+ */
+void stats_game_end(uint16_t score);
+
+/**
+ * Function: void stats_time(uint16_t ms)
+ *
+ * Add ms to the length of the game being played. Call with the time since
+ * the last call, e.g. from a task that counts down its own timers.
+ */
+void stats_time(uint16_t ms);
+
+/**
+ * Function: void stats_ready(uint16_t time)
+ *
+ * Record the tick_ms() time at which the next step became available to the
+ * player.
+ *
+ * Example usage: stats_ready(tick_ms());
+ */
+void stats_ready(uint16_t time);
+
+/**
+ * Function: void stats_press(uint16_t time)
+ *
+ * Time a press (e.g. the time stamp of a button event) against the last
+ * stats_ready() time.
+ *
+ * Example usage: stats_press(buttonEvent.time);
+ */
+void stats_press(uint16_t time);
+
+/**
+ * Function: void stats_wake(uint16_t ns)
+ *
+ * Record the time from the processor waking up from sleep to its first LED
+ * write. The time before the processor runs, while HFINTOSC starts up after
+ * the IOC edge, can't be measured by the firmware.
+ *
+ * Example usage: stats_wake(TMR1 * 250);
+ */
+void stats_wake(uint16_t ns);
+
+/**
+ * Function: uint16_t stats_reaction_mean(void)
+ *
+ * Return the mean reaction time (ms), or 0 if no presses have been timed.
+ */
+uint16_t stats_reaction_mean(void);
+
+/**
+ * Function: const stats_t *stats_read(void)
+ *
+ * Return a pointer to the statistics.
+ *
+ * Example usage: best = stats_read()->bestScore;
+ */
+const stats_t *stats_read(void);
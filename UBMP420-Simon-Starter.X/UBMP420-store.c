@@ -0,0 +1,260 @@
+/*==============================================================================
+ File: UBMP420-store.c
+ Date: October 16, 2026
+
+ UBMP4.2 (PIC16F1459) persistent record store
+
+ Records are numbered by slot, 0 to STORE_SLOTS - 1, around the HEF rows.
+ Sequence numbers are compared by their difference, so they can wrap.
+ Only the low byte of each flash word is used (the high bits are left
+ erased), and a blank slot reads 0xFF in every byte.
+==============================================================================*/
+
+#include    "xc.h"              // XC compiler general include file
+
+#include    "stdint.h"          // Include integer definitions
+#include    "stdbool.h"         // Include Boolean (true/false) definitions
+
+#include    "UBMP420.h"         // Include UBMP4.2 constant & function definitions
+#include    "UBMP420-store.h"   // Include persistent record store definitions
+
+#define STORE_ROW_SLOTS (STORE_ROW_SIZE / STORE_RECORD) // Slots per row
+
+unsigned char storeBuffer[STORE_RECORD];    // Record waiting to be written
+bool storeWaiting = false;      // storeBuffer holds an unwritten record
+bool storeFound = false;        // HEF holds a valid record
+unsigned char storeLast;        // Slot of the newest valid record
+unsigned char storeNext = 0;    // Slot to write next
+uint16_t storeSeq = 0;          // Sequence number of the next record
+
+// Read the low byte of a flash word.
+static unsigned char flash_read(uint16_t addr)
+{
+    PMADRH = (unsigned char)(addr >> 8);
+    PMADRL = (unsigned char)addr;
+    CFGS = 0;                   // Program memory, not configuration words
+    RD = 1;
+    NOP();
+    NOP();
+    return(PMDATL);
+}
+
+// Unlock and start a flash operation. The processor stalls until it's done.
+static void flash_unlock(void)
+{
+    bool interrupts = GIE;
+
+    di();                       // The unlock sequence must not be interrupted
+    PMCON2 = 0x55;
+    PMCON2 = 0xAA;
+    WR = 1;
+    NOP();
+    NOP();
+    if(interrupts)
+    {
+        ei();
+    }
+}
+
+// Erase a flash row (all words read 0x3FFF).
+static void flash_erase(uint16_t addr)
+{
+    PMADRH = (unsigned char)(addr >> 8);
+    PMADRL = (unsigned char)addr;
+    CFGS = 0;
+    FREE = 1;                   // Row erase
+    WREN = 1;
+    flash_unlock();
+    WREN = 0;
+    FREE = 0;
+}
+
+// Write bytes to the low bytes of consecutive words in one flash row. Each
+// word but the last only loads a write latch, and the last writes the row.
+static void flash_write(uint16_t addr, const unsigned char *bytes, unsigned char count)
+{
+    CFGS = 0;
+    WREN = 1;
+    LWLO = 1;                   // Load write latches only
+    while(count != 0)
+    {
+        count--;
+        PMADRH = (unsigned char)(addr >> 8);
+        PMADRL = (unsigned char)addr;
+        PMDATL = *bytes;
+        PMDATH = 0x3F;          // Leave the high bits erased
+        if(count == 0)
+        {
+            LWLO = 0;           // Last word: write the row
+        }
+        flash_unlock();
+        addr++;
+        bytes++;
+    }
+    WREN = 0;
+}
+
+// Return the flash address of a slot.
+static uint16_t slot_addr(unsigned char slot)
+{
+    return(STORE_START + (uint16_t)slot * STORE_RECORD);
+}
+
+// Return the CRC-8 (polynomial 0x07) of the sequence number and data of a
+// record.
+static unsigned char store_crc(const unsigned char *record)
+{
+    unsigned char crc = 0xFF;
+    unsigned char i;
+    unsigned char bit;
+
+    for(i = 0; i != STORE_RECORD - 1; i++)
+    {
+        crc ^= record[i];
+        for(bit = 0; bit != 8; bit++)
+        {
+            if(crc & 0x80)
+            {
+                crc = (unsigned char)(crc << 1) ^ 0x07;
+            }
+            else
+            {
+                crc = (unsigned char)(crc << 1);
+            }
+        }
+    }
+    return(crc);
+}
+
+// Read a slot into record. Returns true if it holds a valid record.
+static bool slot_read(unsigned char slot, unsigned char *record)
+{
+    uint16_t addr = slot_addr(slot);
+    unsigned char i;
+
+    for(i = 0; i != STORE_RECORD; i++)
+    {
+        record[i] = flash_read(addr + i);
+    }
+    return(store_crc(record) == record[STORE_RECORD - 1]);
+}
+
+// Return true if a slot is erased.
+static bool slot_blank(unsigned char slot)
+{
+    uint16_t addr = slot_addr(slot);
+    unsigned char i;
+
+    for(i = 0; i != STORE_RECORD; i++)
+    {
+        if(flash_read(addr + i) != 0xFF)
+        {
+            return(false);
+        }
+    }
+    return(true);
+}
+
+// Return the first slot of the row after the one holding slot.
+static unsigned char next_row(unsigned char slot)
+{
+    return((unsigned char)((slot | (STORE_ROW_SLOTS - 1)) + 1) & (STORE_SLOTS - 1));
+}
+
+// Find the newest valid record and copy its data.
+bool store_init(unsigned char *data)
+{
+    unsigned char record[STORE_RECORD];
+    unsigned char slot;
+    unsigned char i;
+    uint16_t seq;
+
+    storeFound = false;
+    for(slot = 0; slot != STORE_SLOTS; slot++)
+    {
+        if(slot_read(slot, record))
+        {
+            seq = (uint16_t)(record[0] | (record[1] << 8));
+            if(!storeFound || (int16_t)(seq - storeSeq) >= 0)
+            {
+                storeFound = true;
+                storeLast = slot;
+                storeSeq = seq + 1;
+                for(i = 0; i != STORE_DATA; i++)
+                {
+                    data[i] = record[i + 2];
+                }
+            }
+        }
+    }
+    storeNext = storeFound ? (storeLast + 1) & (STORE_SLOTS - 1) : 0;
+    return(storeFound);
+}
+
+// Buffer data to be written by store_flush().
+void store_write(const unsigned char *data)
+{
+    unsigned char i;
+
+    for(i = 0; i != STORE_DATA; i++)
+    {
+        storeBuffer[i + 2] = data[i];
+    }
+    storeWaiting = true;
+}
+
+bool store_pending(void)
+{
+    return(storeWaiting);
+}
+
+// Write the buffered record to the next free slot.
+void store_flush(void)
+{
+    unsigned char record[STORE_RECORD];
+    unsigned char slot = storeNext;
+    unsigned char tries;
+    unsigned char i;
+
+    if(!storeWaiting)
+    {
+        return;
+    }
+    storeBuffer[0] = (unsigned char)storeSeq;
+    storeBuffer[1] = (unsigned char)(storeSeq >> 8);
+    storeBuffer[STORE_RECORD - 1] = store_crc(storeBuffer);
+    for(tries = 0; tries != STORE_ROWS; tries++)
+    {
+        // A slot in a row that's in use must be blank (a power loss can
+        // leave a torn record after the newest one), otherwise start a row
+        if((slot & (STORE_ROW_SLOTS - 1)) != 0 && !slot_blank(slot))
+        {
+            slot = next_row(slot);
+        }
+        if((slot & (STORE_ROW_SLOTS - 1)) == 0)
+        {
+            if(storeFound && slot == (storeLast & ~(STORE_ROW_SLOTS - 1)))
+            {
+                return;         // Never erase the newest record
+            }
+            flash_erase(slot_addr(slot));
+        }
+        flash_write(slot_addr(slot), storeBuffer, STORE_RECORD);
+        slot_read(slot, record);    // Check it (a worn row may not take it)
+        i = 0;
+        while(i != STORE_RECORD && record[i] == storeBuffer[i])
+        {
+            i++;
+        }
+        if(i == STORE_RECORD)
+        {
+            storeFound = true;
+            storeLast = slot;
+            storeNext = (slot + 1) & (STORE_SLOTS - 1);
+            storeSeq++;
+            storeWaiting = false;
+            return;
+        }
+        slot = next_row(slot);  // Try a fresh row
+    }
+}
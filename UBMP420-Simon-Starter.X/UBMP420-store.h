@@ -0,0 +1,70 @@
+/*==============================================================================
+ File: UBMP420-store.h
+ Date: October 16, 2026
+
+ UBMP4.2 (PIC16F1459) persistent record store definitions
+
+ Saves a few bytes of data (e.g. the best score and game counters) in the
+ PIC16F1459's High-Endurance Flash (HEF): the low bytes of the last 128
+ words of program memory, 0x1F80-0x1FFF, which take 100,000 erases instead
+ of the 10,000 of the rest of the flash. The project reserves these words
+ so no code is placed there.
+
+ Each save appends an 8-byte record - a 16-bit sequence number, STORE_DATA
+ data bytes and a CRC-8 - to a log that runs around all four HEF rows (16
+ records). A row is only erased when the log moves into it, so every row
+ wears at the same rate, once every 16 saves. At start-up store_init()
+ picks the valid record with the newest sequence number. A record that was
+ torn by a power loss fails its CRC and is ignored, and the row being
+ erased never holds the newest record, so a power loss never loses more
+ than the save being made.
+
+ The PIC16 processor stops while a flash row is erased or written (about
+ 2 ms each), so store_write() only copies the data into a RAM buffer, and
+ store_flush() writes it when the program has time to stall, e.g. just
+ before going to sleep.
+==============================================================================*/
+
+// Store settings
+#define STORE_START     0x1F80      // HEF start address (words)
+#define STORE_ROWS      4           // HEF erase rows
+#define STORE_ROW_SIZE  32          // Words (data bytes) per row
+#define STORE_RECORD    8           // Bytes per record
+#define STORE_SLOTS     (STORE_ROWS * STORE_ROW_SIZE / STORE_RECORD)
+#define STORE_DATA      5           // Data bytes per record
+
+/**
+ * Function: bool store_init(unsigned char *data)
+ *
+ * Find the newest valid record in HEF and copy its STORE_DATA data bytes to
+ * data. Returns false (and leaves data unchanged) if there are none, e.g.
+ * in a new chip. Call once at start-up.
+ *
+ * Example usage: if(store_init(saved)) { ... }
+ */
+bool store_init(unsigned char *);
+
+/**
+ * Function: void store_write(const unsigned char *data)
+ *
+ * Save STORE_DATA bytes in the RAM buffer, to be written to HEF by the next
+ * store_flush(). A newer save replaces one that hasn't been written yet.
+ */
+void store_write(const unsigned char *);
+
+/**
+ * Function: bool store_pending(void)
+ *
+ * Return true if the RAM buffer holds data not yet written to HEF.
+ */
+bool store_pending(void);
+
+/**
+ * Function: void store_flush(void)
+ *
+ * Write the buffered data, if any, to HEF. Stalls the processor for about
+ * 2 ms, or 4 ms when a row has to be erased first, with interrupts held off.
+ * Each record is read back, and if a worn-out row doesn't take it the next
+ * row is tried. If no row takes it the data stays buffered.
+ */
+void store_flush(void);
@@ -0,0 +1,219 @@
+/*==============================================================================
+ File: UBMP420-tick.c
+ Date: October 16, 2026
+
+ UBMP4.2 (PIC16F1459) 1 ms system tick and cooperative task scheduler
+
+ Timer2 interrupts once every millisecond. The interrupt only counts the tick
+ and sets a flag - the tasks themselves run from tick_run() in the main loop,
+ so they never need to be interrupt-safe.
+==============================================================================*/
+
+#include    "xc.h"              // XC compiler general include file
+
+#include    "stdint.h"          // Include integer definitions
+#include    "stdbool.h"         // Include Boolean (true/false) definitions
+
+#include    "UBMP420.h"         // Include UBMP4.2 constant & function definitions
+#include    "UBMP420-tick.h"    // Include system tick definitions
+
+// System tick variables (shared with the interrupt)
+volatile uint16_t tickCount = 0;        // Free-running millisecond counter
+volatile bool tickFlag = false;         // Set by each tick, cleared by tick_run()
+
+// Inactivity timer variables (shared with the interrupt)
+uint16_t idleTimeout = 0;               // Time-out period (s)
+volatile uint16_t idleSeconds = 0;      // Seconds left (0 = timer stopped)
+volatile uint16_t idleMs = 0;           // Milliseconds into the current second
+volatile bool idleExpired = false;      // Set when the time runs out
+
+// Sleep time not yet counted (LFINTOSC cycles, less than 1 ms)
+unsigned char tickSleepCycles = 0;
+bool tickSlow = false;                  // Left on HFINTOSC by tick_sleep()
+
+// Configure Timer2 for a 1 ms tick interrupt and start it.
+void tick_config(void)
+{
+    PR2 = TICK_PR2;             // Set Timer2 period to 150 counts
+    TMR2 = 0;
+    T2CON = TICK_T2CON;         // 1:5 postscaler, Timer2 on, 1:16 prescaler
+    TMR2IF = 0;                 // Clear Timer2 interrupt flag
+    TMR2IE = 1;                 // Enable Timer2 interrupt
+    PEIE = 1;                   // Enable peripheral interrupts
+}
+
+// Wait for the next tick and run each task whose period has elapsed.
+void tick_run(task_t *tasks, unsigned char count)
+{
+    while(!tickFlag)            // Wait for the next tick
+        WAIT_EVENT();
+    tickFlag = false;
+
+    while(count != 0)           // Run each task that is due
+    {
+        tasks->count++;
+        if(tasks->count >= tasks->period)
+        {
+            tasks->count = 0;
+            tasks->run();
+        }
+        tasks++;
+        count--;
+    }
+}
+
+// Return the free-running millisecond tick count.
+uint16_t tick_ms(void)
+{
+    uint16_t ms;
+
+    TMR2IE = 0;                 // Read both bytes without a tick in between
+    ms = tickCount;
+    TMR2IE = 1;
+    return(ms);
+}
+
+// Add cycles LFINTOSC cycles of time spent asleep to the tick and inactivity
+// timers, carrying the part of a millisecond left over to the next sleep.
+// Called with interrupts disabled.
+static void tick_add(uint16_t cycles)
+{
+    unsigned char ms = 0;
+
+    cycles += tickSleepCycles;
+    while(cycles >= TICK_LFINTOSC)
+    {
+        cycles -= TICK_LFINTOSC;
+        ms++;
+    }
+    tickSleepCycles = (unsigned char)cycles;
+    tickCount += ms;
+    if(idleSeconds != 0)
+    {
+        idleMs += ms;
+        if(idleMs >= 1000)
+        {
+            idleMs -= 1000;
+            idleSeconds--;
+            if(idleSeconds == 0)
+            {
+                idleExpired = true;
+            }
+        }
+    }
+}
+
+// Sleep until an interrupt or the watchdog wakes the processor, and count the
+// time slept. Call (and return) with interrupts disabled.
+void tick_sleep(unsigned char wdt)
+{
+    uint16_t cycles = 32 << ((wdt >> 1) & 0x1F);        // Watchdog period
+
+    OSC_sleep_clock();          // Wake up on HFINTOSC, without the PLL delay
+    tickSlow = true;
+    CLRWDT();                   // Set nPD and nTO, so SLEEP shows what it did
+    WDTCON = wdt;               // Start the watchdog as a wake-up timer
+    SLEEP();
+    SWDTEN = 0;                 // Stop the watchdog so it can't reset the PIC
+    if(nTO == 1)                // Woken part way through by an interrupt?
+    {
+        if(nPD == 1)            // SLEEP was a NOP (an interrupt flag was
+        {                       // already set), so no time has passed
+            cycles = 0;
+        }
+        else                    // Count half the period
+        {
+            cycles = cycles >> 1;
+        }
+        if(!OSC_fast())         // Let the PLL lock while the press is
+        {                       // debounced. Timer2 runs 3x slower until then
+            cycles += TICK_PLL_LOCK - TICK_PLL_LOCK / 3;
+        }
+        OSC_wake_clock();
+        tickSlow = false;
+    }
+    tick_add(cycles);
+    tickFlag = true;            // Let tick_run() run the tasks right away
+}
+
+// Switch back to the 48 MHz PLL clock after tick_sleep(), holding the tick
+// while the PLL locks and then counting the lock time. Call (and return) with
+// interrupts disabled.
+void tick_wake(void)
+{
+    if(!tickSlow)
+    {
+        return;
+    }
+    tickSlow = false;
+    OSC_wake_clock();           // Switch to the PLL when it's ready
+    if(OSC_fast())              // (at once if it has already locked)
+    {
+        return;
+    }
+    TMR2ON = 0;                 // Hold the tick at the slow clock rate and
+    while(!OSC_fast())          // count the lock time instead
+        WAIT_EVENT();
+    TMR2ON = 1;
+    tick_add(TICK_PLL_LOCK);
+}
+
+// Start the inactivity timer with a time-out period in seconds.
+void tick_idle_start(uint16_t seconds)
+{
+    TMR2IE = 0;                 // Update the timer without a tick in between
+    idleTimeout = seconds;
+    idleSeconds = seconds;
+    idleMs = 0;
+    idleExpired = false;
+    TMR2IE = 1;
+}
+
+// Restart the inactivity time-out period if the timer is running.
+void tick_idle_reset(void)
+{
+    TMR2IE = 0;
+    if(idleSeconds != 0)
+    {
+        idleSeconds = idleTimeout;
+        idleMs = 0;
+    }
+    TMR2IE = 1;
+}
+
+// Stop the inactivity timer.
+void tick_idle_stop(void)
+{
+    TMR2IE = 0;
+    idleSeconds = 0;
+    idleExpired = false;
+    TMR2IE = 1;
+}
+
+// Return true if the inactivity timer has timed out.
+bool tick_idle_expired(void)
+{
+    return(idleExpired);
+}
+
+// Timer2 interrupt service function. Call from the interrupt function.
+void tick_isr(void)
+{
+    TMR2IF = 0;                 // Clear Timer2 interrupt flag
+    tickCount++;                // Count the tick and signal tick_run()
+    tickFlag = true;
+
+    if(idleSeconds != 0)        // Count down the inactivity timer
+    {
+        idleMs++;
+        if(idleMs == 1000)
+        {
+            idleMs = 0;
+            idleSeconds--;
+            if(idleSeconds == 0)
+            {
+                idleExpired = true; // Time's up
+            }
+        }
+    }
+}
@@ -0,0 +1,161 @@
+/*==============================================================================
+ File: UBMP420-tick.h
+ Date: October 16, 2026
+
+ UBMP4.2 (PIC16F1459) 1 ms system tick and cooperative task scheduler
+ definitions
+
+ Timer2 generates an interrupt every 1 ms. Each tick advances a free-running
+ millisecond counter and lets tick_run() call the program's tasks. Tasks are
+ short functions that do a little work and return (they must not wait), so
+ several tasks can share the processor and each one runs at least once every
+ period ticks.
+
+ The tick interrupt also runs an inactivity timer. Once started, it counts
+ seconds until tick_idle_reset() restarts it (call it for every user action)
+ and flags a time-out from the interrupt when the time runs out.
+
+ tick_sleep() is the low-power alternative to waiting for ticks. It stops the
+ processor for up to one watchdog period (about 1 ms or 33 ms) and then adds
+ the time slept to the tick count, so program timing carries on across
+ sleeps. The time is counted in LFINTOSC cycles and carried over between
+ sleeps, so the tick count doesn't drift from the 31 kHz watchdog clock. An
+ interrupt that ends a sleep early can't tell how long the processor slept,
+ so it counts half of the period: use the short period while a button press
+ is expected and must be timed.
+
+ The processor sleeps and wakes on the 16 MHz HFINTOSC, so a run of sleeps
+ doesn't wait 2 ms for the PLL to lock after each one. An interrupt wake-up
+ switches back to the PLL at once, and tick_wake() switches back when there
+ is something to do after a watchdog wake-up.
+
+ The program's interrupt function must call tick_isr() when TMR2IF is set.
+==============================================================================*/
+
+// Timer2 settings for a 1 ms tick at 48 MHz: FOSC/4 (12 MHz) / 16 prescaler
+// / 150 counts (PR2 = 149) / 5 postscaler = 1000 Hz.
+#define TICK_PR2    149             // Timer2 period register value
+#define TICK_T2CON  0b00100110      // 1:5 postscaler, Timer2 on, 1:16 prescaler
+
+// Watchdog timer settings for tick_sleep(): 1:32 or 1:1024 of the 31 kHz
+// LFINTOSC
+#define TICK_WDT_SHORT  0b00000001  // WDTCON: 1:32, 1 ms period, SWDTEN on
+#define TICK_WDT_LONG   0b00001011  // WDTCON: 1:1024, 33 ms period, SWDTEN on
+#define TICK_LFINTOSC   31          // LFINTOSC cycles per ms
+#define TICK_PLL_LOCK   62          // PLL lock time after a wake-up (LFINTOSC
+                                    // cycles, 2 ms)
+#define TICK_SLEEP_MS   33          // Longest sleep (TICK_WDT_LONG period, ms)
+
+// Task table entry. Create an array of tasks and pass it to tick_run().
+typedef struct
+{
+    void (*run)(void);              // Task function
+    unsigned char period;           // Ticks between task runs (1 = every tick)
+    unsigned char count;            // Ticks since task last ran (start at 0)
+} task_t;
+
+/**
+ * Function: void tick_config(void)
+ *
+ * Configure Timer2 for a 1 ms tick interrupt and start it. Global interrupts
+ * (GIE) must also be enabled for the tick to run.
+ */
+void tick_config(void);
+
+/**
+ * Function: void tick_run(task_t *tasks, unsigned char count)
+ *
+ * Wait for the next tick and run each task in the table whose period has
+ * elapsed. Ticks that occur while tasks are running are not queued, so call
+ * tick_run() continuously from the main loop.
+ *
+ * Example usage: tick_run(tasks, sizeof(tasks) / sizeof(tasks[0]));
+ */
+void tick_run(task_t *, unsigned char);
+
+/**
+ * Function: uint16_t tick_ms(void)
+ *
+ * Return the free-running millisecond tick count (wraps every 65.536 s).
+ *
+ * Example usage: start = tick_ms();
+ */
+uint16_t tick_ms(void);
+
+/**
+ * Function: void tick_sleep(unsigned char wdt)
+ *
+ * Sleep until an enabled interrupt (e.g. an IOC button press) or the watchdog
+ * timer wakes the processor, with the watchdog period set by wdt
+ * (TICK_WDT_SHORT or TICK_WDT_LONG), then add the time slept to the tick
+ * count and the inactivity timer: the whole period if the watchdog woke the
+ * processor, half of it if an interrupt did, or nothing if an interrupt flag
+ * was already set and SLEEP didn't stop the processor. The processor runs
+ * from HFINTOSC after a watchdog wake-up, ready to sleep again, and switches
+ * back to the 48 MHz PLL clock as soon as an interrupt wakes it, counting the
+ * time Timer2 runs 3x slower while the PLL locks. Peripherals clocked from
+ * FOSC, including Timer1 tones, stop during sleep, so only use tick_sleep()
+ * when there is nothing to do for the period except wait for a button, and
+ * call tick_wake() before starting anything that needs the 48 MHz clock.
+ * Call with interrupts disabled (di()), after checking that there is nothing
+ * to do. Interrupts are left disabled, so call ei() afterwards to service
+ * them.
+ *
+ * Example usage: di(); if(nothing_to_do) tick_sleep(TICK_WDT_LONG); ei();
+ */
+void tick_sleep(unsigned char);
+
+/**
+ * Function: void tick_wake(void)
+ *
+ * Switch back to the 48 MHz PLL clock if a watchdog wake-up from tick_sleep()
+ * left the processor running from HFINTOSC. The tick is held while the PLL
+ * locks, and TICK_PLL_LOCK is added to it afterwards. Does nothing if the
+ * processor is already running from the PLL clock. Call with interrupts
+ * disabled.
+ *
+ * Example usage: di(); if(nothing_to_do) tick_sleep(TICK_WDT_LONG); else
+ * tick_wake(); ei();
+ */
+void tick_wake(void);
+
+/**
+ * Function: void tick_idle_start(uint16_t seconds)
+ *
+ * Start the inactivity timer. tick_idle_expired() becomes true after seconds
+ * (1-65535) pass without a call to tick_idle_reset().
+ *
+ * Example usage: tick_idle_start(120);
+ */
+void tick_idle_start(uint16_t);
+
+/**
+ * Function: void tick_idle_reset(void)
+ *
+ * Restart the inactivity time-out period, if the timer is running.
+ */
+void tick_idle_reset(void);
+
+/**
+ * Function: void tick_idle_stop(void)
+ *
+ * Stop the inactivity timer and clear its time-out.
+ */
+void tick_idle_stop(void);
+
+/**
+ * Function: bool tick_idle_expired(void)
+ *
+ * Return true if the inactivity timer has timed out.
+ */
+bool tick_idle_expired(void);
+
+/**
+ * Function: void tick_isr(void)
+ *
+ * Timer2 interrupt service function. Counts the tick, flags it for
+ * tick_run(), and counts down the inactivity timer.
+ *
+ * Example usage: if(TMR2IF == 1 && TMR2IE == 1) tick_isr();
+ */
+void tick_isr(void);
@@ -0,0 +1,223 @@
+/*==============================================================================
+ File: UBMP420-tone.c
+ Date: October 16, 2026
+
+ UBMP4.2 (PIC16F1459) interrupt-driven tone generator functions
+
+ Timer1 overflows once every half-period of the tone and the interrupt toggles
+ BEEPER. The number of half-periods left to play is counted down in the
+ interrupt, so tones finish on their own without any help from the program.
+
+ The host simulation's fast build (SIM_FAST) lets each Timer1 period cover as
+ many half-periods as fit in 16 bits and toggles BEEPER once for all of them
+ (only the parity of the toggles matters at the end of a batch). A tone then
+ takes a handful of interrupts instead of one per half-period and still ends
+ on time (to within the reload adjustment, made once per batch), but the
+ beeper no longer plays its pitch.
+==============================================================================*/
+
+#include    "xc.h"              // XC compiler general include file
+
+#include    "stdint.h"          // Include integer definitions
+#include    "stdbool.h"         // Include Boolean (true/false) definitions
+
+#include    "UBMP420.h"         // Include UBMP4.2 constant & function definitions
+#include    "UBMP420-tone.h"    // Include tone generator definitions
+
+// Note table (program memory), from TONE_NOTE_FIRST to TONE_NOTE_LAST
+const tone_note_t toneNotes[TONE_NOTE_LAST - TONE_NOTE_FIRST + 1] =
+{
+    TONE_NOTE(22000),   // A3 (220.00 Hz)
+    TONE_NOTE(23308),   // A#3 (233.08 Hz)
+    TONE_NOTE(24694),   // B3 (246.94 Hz)
+    TONE_NOTE(26163),   // C4 (261.63 Hz)
+    TONE_NOTE(27718),   // C#4 (277.18 Hz)
+    TONE_NOTE(29366),   // D4 (293.66 Hz)
+    TONE_NOTE(31113),   // D#4 (311.13 Hz)
+    TONE_NOTE(32963),   // E4 (329.63 Hz)
+    TONE_NOTE(34923),   // F4 (349.23 Hz)
+    TONE_NOTE(36999),   // F#4 (369.99 Hz)
+    TONE_NOTE(39200),   // G4 (392.00 Hz)
+    TONE_NOTE(41530),   // G#4 (415.30 Hz)
+    TONE_NOTE(44000),   // A4 (440.00 Hz)
+    TONE_NOTE(46616),   // A#4 (466.16 Hz)
+    TONE_NOTE(49388),   // B4 (493.88 Hz)
+    TONE_NOTE(52325),   // C5 (523.25 Hz)
+    TONE_NOTE(55437),   // C#5 (554.37 Hz)
+    TONE_NOTE(58733),   // D5 (587.33 Hz)
+    TONE_NOTE(62225),   // D#5 (622.25 Hz)
+    TONE_NOTE(65926),   // E5 (659.26 Hz)
+    TONE_NOTE(69846),   // F5 (698.46 Hz)
+    TONE_NOTE(73999),   // F#5 (739.99 Hz)
+    TONE_NOTE(78399),   // G5 (783.99 Hz)
+    TONE_NOTE(83061),   // G#5 (830.61 Hz)
+    TONE_NOTE(88000),   // A5 (880.00 Hz)
+    TONE_NOTE(93233),   // A#5 (932.33 Hz)
+    TONE_NOTE(98777),   // B5 (987.77 Hz)
+    TONE_NOTE(104650),  // C6 (1046.50 Hz)
+    TONE_NOTE(110873),  // C#6 (1108.73 Hz)
+    TONE_NOTE(117466),  // D6 (1174.66 Hz)
+    TONE_NOTE(124451),  // D#6 (1244.51 Hz)
+    TONE_NOTE(131851),  // E6 (1318.51 Hz)
+    TONE_NOTE(139691),  // F6 (1396.91 Hz)
+    TONE_NOTE(147998),  // F#6 (1479.98 Hz)
+    TONE_NOTE(156798),  // G6 (1567.98 Hz)
+    TONE_NOTE(166122),  // G#6 (1661.22 Hz)
+    TONE_NOTE(176000)   // A6 (1760.00 Hz)
+};
+
+// Tone generator variables (shared with the interrupt)
+uint16_t toneReload;                // Timer1 reload value for each half-period
+volatile uint16_t toneToggles;      // Beeper toggles left to play
+volatile bool tonePlaying = false;  // True while a tone is playing
+
+#ifdef SIM_FAST
+uint16_t toneHalf;                  // Timer1 counts per half-period
+uint16_t toneBatch;                 // Half-periods in each Timer1 period
+
+// Set up the reload for a batch of up to toggles half-periods.
+static void tone_batch(uint16_t toggles)
+{
+    toneBatch = 0xFFFF / toneHalf;
+    if(toneBatch > toggles)
+    {
+        toneBatch = toggles;
+    }
+    toneReload = 0 - toneHalf * toneBatch + TONE_RELOAD_ADJUST;
+}
+#endif
+
+// Configure Timer1 and enable its interrupt for tone generation.
+void tone_config(void)
+{
+    T1CON = 0b00110000;         // Timer1 from FOSC/4, 1:8 prescaler, timer off
+    T1GCON = 0b00000000;        // Disable Timer1 gate (count whenever on)
+    TMR1IF = 0;                 // Clear Timer1 interrupt flag
+    TMR1IE = 1;                 // Enable Timer1 overflow interrupt
+    PEIE = 1;                   // Enable peripheral interrupts
+}
+
+// Stop Timer1 and drop any overflow still pending. tonePlaying is cleared
+// first, so an interrupt taken on the way can't restart the timer.
+static void tone_halt(void)
+{
+    tonePlaying = false;
+    TMR1ON = 0;
+    TMR1IF = 0;
+}
+
+// Start Timer1 with half-period reloads of half counts for toggles beeper
+// toggles (clamped to 1-65535).
+static void tone_play(uint16_t half, uint32_t toggles)
+{
+    if(toggles == 0)
+    {
+        toggles = 1;
+    }
+    else if(toggles > 0xFFFF)
+    {
+        toggles = 0xFFFF;
+    }
+    toneToggles = (uint16_t)toggles;
+#ifdef SIM_FAST
+    toneHalf = half;
+    tone_batch(toneToggles);
+#else
+    toneReload = 0 - half + TONE_RELOAD_ADJUST;
+#endif
+
+    TMR1 = toneReload;          // Load first half-period and start the timer
+    TMR1IF = 0;
+    tonePlaying = true;
+    TMR1ON = 1;
+}
+
+// Start playing a tone of freq Hz for duration ms and return immediately.
+void tone_start(uint16_t freq, uint16_t duration)
+{
+    tone_halt();                // Stop any tone that is already playing
+    if(freq == 0 || duration == 0)
+    {
+        BEEPER = 0;
+        return;
+    }
+
+    // Each half-period is TONE_TIMER_FREQ / (2 * freq) Timer1 counts, and
+    // there are 2 * freq half-periods (toggles) in every second of tone.
+    tone_play((uint16_t)(TONE_TIMER_FREQ / 2 / freq),
+              ((uint32_t)freq * duration) / 500);
+}
+
+// Start playing a note from the note table for duration ms and return.
+void tone_note(unsigned char note, uint16_t duration)
+{
+    const tone_note_t *entry;
+
+    tone_halt();                // Stop any tone that is already playing
+    if(note < TONE_NOTE_FIRST || note > TONE_NOTE_LAST || duration == 0)
+    {
+        BEEPER = 0;
+        return;
+    }
+
+    // Toggles = duration * toggles per ms, rounded (4.12 fixed point)
+    entry = &toneNotes[note - TONE_NOTE_FIRST];
+    tone_play(entry->half, ((uint32_t)duration * entry->rate + 2048) >> 12);
+}
+
+// Stop the current tone and turn the beeper off.
+void tone_stop(void)
+{
+    tone_halt();
+    BEEPER = 0;
+}
+
+// Return true while a tone is playing.
+bool tone_busy(void)
+{
+    return(tonePlaying);
+}
+
+// Timer1 interrupt service function. Call from the interrupt function.
+void tone_isr(void)
+{
+    TMR1IF = 0;                 // Clear Timer1 interrupt flag
+    if(!tonePlaying)            // Overflow left over from a stopped tone?
+    {
+        return;                 // Leave the timer and beeper off
+    }
+#ifdef SIM_FAST
+    if(toneBatch & 1)           // Toggle the beeper once for the whole batch
+    {
+        BEEPER = !BEEPER;
+    }
+    toneToggles -= toneBatch;
+    if(toneToggles == 0)
+    {
+        TMR1ON = 0;
+        BEEPER = 0;
+        tonePlaying = false;
+        return;
+    }
+    if(toneToggles < toneBatch) // Shorter last batch
+    {
+        tone_batch(toneToggles);
+    }
+    TMR1ON = 0;
+    TMR1 = TMR1 + toneReload;
+    TMR1ON = 1;
+#else
+    TMR1ON = 0;                 // Reload Timer1 for the next half-period, adding
+    TMR1 = TMR1 + toneReload;   // the counts already made since the overflow
+    TMR1ON = 1;
+
+    BEEPER = !BEEPER;           // Toggle the beeper and count the half-period
+    toneToggles--;
+    if(toneToggles == 0)        // Tone finished? Stop the timer and beeper
+    {
+        TMR1ON = 0;
+        BEEPER = 0;
+        tonePlaying = false;
+    }
+#endif
+}
@@ -0,0 +1,136 @@
+/*==============================================================================
+ File: UBMP420-tone.h
+ Date: October 16, 2026
+
+ UBMP4.2 (PIC16F1459) interrupt-driven tone generator definitions
+
+ The tone generator toggles the piezo beeper (LS1) from the Timer1 overflow
+ interrupt, so a note plays in the background while the main program keeps
+ running. Timer1 is clocked from FOSC/4 through a 1:8 prescaler (1.5 MHz at
+ 48 MHz), giving usable tone frequencies from 12 Hz up to several kHz.
+
+ Notes from A3 to A6 are played from a table in program memory, by note
+ number (the MIDI note number, named by the NOTE_ constants). The table
+ holds each note's Timer1 half-period and its beeper toggles per ms, both
+ calculated by the compiler from the equal-tempered pitch, so tone_note()
+ needs no division and plays each note for the requested time to within
+ one half-period.
+
+ The program's interrupt function must call tone_isr() when TMR1IF is set.
+==============================================================================*/
+
+// Musical note numbers (MIDI note numbers) for tone_note()
+#define NOTE_A3     57              // A3
+#define NOTE_AS3    58              // A#3
+#define NOTE_B3     59              // B3
+#define NOTE_C4     60              // C4
+#define NOTE_CS4    61              // C#4
+#define NOTE_D4     62              // D4
+#define NOTE_DS4    63              // D#4
+#define NOTE_E4     64              // E4
+#define NOTE_F4     65              // F4
+#define NOTE_FS4    66              // F#4
+#define NOTE_G4     67              // G4
+#define NOTE_GS4    68              // G#4
+#define NOTE_A4     69              // A4
+#define NOTE_AS4    70              // A#4
+#define NOTE_B4     71              // B4
+#define NOTE_C5     72              // C5
+#define NOTE_CS5    73              // C#5
+#define NOTE_D5     74              // D5
+#define NOTE_DS5    75              // D#5
+#define NOTE_E5     76              // E5
+#define NOTE_F5     77              // F5
+#define NOTE_FS5    78              // F#5
+#define NOTE_G5     79              // G5
+#define NOTE_GS5    80              // G#5
+#define NOTE_A5     81              // A5
+#define NOTE_AS5    82              // A#5
+#define NOTE_B5     83              // B5
+#define NOTE_C6     84              // C6
+#define NOTE_CS6    85              // C#6
+#define NOTE_D6     86              // D6
+#define NOTE_DS6    87              // D#6
+#define NOTE_E6     88              // E6
+#define NOTE_F6     89              // F6
+#define NOTE_FS6    90              // F#6
+#define NOTE_G6     91              // G6
+#define NOTE_GS6    92              // G#6
+#define NOTE_A6     93              // A6
+#define TONE_NOTE_FIRST NOTE_A3     // Lowest note in the note table
+#define TONE_NOTE_LAST  NOTE_A6     // Highest note in the note table
+
+// Tone timer definitions
+#define TONE_TIMER_FREQ (_XTAL_FREQ / 4 / 8)   // Timer1 count rate (1:8 prescale)
+#define TONE_RELOAD_ADJUST 1        // Counts lost while reloading Timer1
+
+// Note table entry for a pitch of f100 hundredths of a Hz: Timer1 counts per
+// half-period (rounded), and beeper toggles per ms of that half-period in
+// 4.12 fixed point (toggles per ms * 4096).
+#define TONE_HALF(f100) ((TONE_TIMER_FREQ * 100UL + (f100)) / (2UL * (f100)))
+#define TONE_RATE(f100) ((TONE_TIMER_FREQ / 1000UL * 4096UL + TONE_HALF(f100) / 2) / TONE_HALF(f100))
+#define TONE_NOTE(f100) {TONE_HALF(f100), TONE_RATE(f100)}
+
+typedef struct
+{
+    uint16_t half;                  // Timer1 counts per half-period
+    uint16_t rate;                  // Toggles per ms (4.12 fixed point)
+} tone_note_t;
+
+/**
+ * Function: void tone_config(void)
+ *
+ * Configure Timer1 and enable its interrupt for tone generation. Global
+ * interrupts (GIE) must also be enabled for tones to play.
+ */
+void tone_config(void);
+
+/**
+ * Function: void tone_start(uint16_t freq, uint16_t duration)
+ *
+ * Start playing a tone of freq Hz for duration ms and return immediately. A
+ * new tone replaces any tone already playing. A freq or duration of 0 stops
+ * the beeper. Use tone_note() for musical notes - it avoids the divisions
+ * needed here.
+ *
+ * Example usage: tone_start(1000, 250);
+ */
+void tone_start(uint16_t, uint16_t);
+
+/**
+ * Function: void tone_note(unsigned char note, uint16_t duration)
+ *
+ * Start playing a note (TONE_NOTE_FIRST to TONE_NOTE_LAST, e.g. NOTE_A5)
+ * from the note table for duration ms and return immediately. A new tone
+ * replaces any tone already playing. A note outside the table or a duration
+ * of 0 stops the beeper.
+ *
+ * Example usage: tone_note(NOTE_A5, 250);
+ */
+void tone_note(unsigned char, uint16_t);
+
+/**
+ * Function: void tone_stop(void)
+ *
+ * Stop the current tone and turn the beeper off.
+ */
+void tone_stop(void);
+
+/**
+ * Function: bool tone_busy(void)
+ *
+ * Return true while a tone is playing.
+ *
+ * Example usage: while(tone_busy());
+ */
+bool tone_busy(void);
+
+/**
+ * Function: void tone_isr(void)
+ *
+ * Timer1 interrupt service function. Reloads Timer1 for the next half-period,
+ * toggles the beeper, and stops the tone when its duration has elapsed.
+ *
+ * Example usage: if(TMR1IF == 1 && TMR1IE == 1) tone_isr();
+ */
+void tone_isr(void);
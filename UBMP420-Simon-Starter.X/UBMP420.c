@@ -25,6 +25,24 @@ void OSC_config(void)
     while(!PLLRDY);             // Wait for PLL lock (disable for simulation)
 }
 
+// Run from 16 MHz HFINTOSC without the PLL (before SLEEP, for a faster wake-up).
+void OSC_sleep_clock(void)
+{
+    OSCCON = 0xFE;              // Select internal oscillator block (SCS = 1x)
+}
+
+// Switch back to the 48 MHz PLL clock once the PLL has locked.
+void OSC_wake_clock(void)
+{
+    OSCCON = 0xFC;              // Select PLL clock (switches when PLL is ready)
+}
+
+// Return true once running from the 48 MHz PLL clock.
+bool OSC_fast(void)
+{
+    return(PLLRDY);
+}
+
 // Configure hardware ports and peripherals for on-board UBMP4 I/O devices.
 void UBMP4_config(void)
 {
@@ -79,7 +97,7 @@ unsigned char ADC_read(void)
 {
     GO = 1;                     // Start the conversion by setting Go/~Done bit
 	while(GO)                   // Wait for the conversion to finish (GO==0)
-        ;                       // (terminate the empty while loop)
+        WAIT_EVENT();           // (empty loop body on the PIC)
     return (ADRESH);            // Return the MSB (upper 8-bits) of the result
 }
 
@@ -93,7 +111,7 @@ unsigned char ADC_read_channel(unsigned char channel)
     __delay_us(5);              // Allow input to settle (charges internal cap.)
     GO = 1;                     // Start the conversion by setting Go/~Done bit
 	while(GO)                   // Wait for the conversion to finish (GO==0)
-        ;                       // (terminate the empty while loop)
+        WAIT_EVENT();           // (empty loop body on the PIC)
     ADON = 0;                   // Turn the A-D converter off
     return (ADRESH);            // Return the MSB (upper 8-bits) of the result
 }
\ No newline at end of file
@@ -102,6 +102,13 @@
 // Clock frequency definition for delay macros and simulation
 #define _XTAL_FREQ  48000000        // Set clock frequency for time delays
 
+// Busy-wait loop body. Use in loops that wait for an interrupt or peripheral
+// flag, e.g. while(GO) WAIT_EVENT(); It does nothing on the PIC16F1459. Host
+// simulation builds (sim/xc.h) define it to advance their virtual clock.
+#ifndef WAIT_EVENT
+#define WAIT_EVENT()
+#endif
+
 // Prototypes for UBMP420.c functions:
 
 /**
@@ -111,6 +118,34 @@
  */
 void OSC_config(void);
 
+/**
+ * Function: void OSC_sleep_clock(void)
+ * 
+ * Run from the 16 MHz HFINTOSC without the PLL. Call just before SLEEP so the
+ * processor starts running as soon as HFINTOSC is up after waking, instead of
+ * waiting for the PLL to lock. Timers and delays run 3x slower until the
+ * clock is back at 48 MHz, so call OSC_wake_clock() right after waking.
+ */
+void OSC_sleep_clock(void);
+
+/**
+ * Function: void OSC_wake_clock(void)
+ * 
+ * Switch back to the 48 MHz PLL clock after waking. The processor keeps
+ * running from HFINTOSC until the PLL locks, and then switches over by itself.
+ */
+void OSC_wake_clock(void);
+
+/**
+ * Function: bool OSC_fast(void)
+ * 
+ * Return true once the PLL has locked after OSC_wake_clock() and the processor
+ * is running at 48 MHz again.
+ * 
+ * Example usage: while(!OSC_fast());
+ */
+bool OSC_fast(void);
+
 /**
  * Function: void UBMP4_config(void)
  * 
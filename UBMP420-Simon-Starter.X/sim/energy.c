@@ -0,0 +1,264 @@
+/*==============================================================================
+ File: sim/energy.c
+ Date: October 16, 2026
+
+ Energy accounting model for the UBMP4.2 host simulator
+
+ The model sits in front of the player's hooks. Every hook call is a sample:
+ the time since the last one is charged to the loads that were on then (and
+ to the firmware part that was running), and the register settings are read
+ again for the next interval.
+==============================================================================*/
+
+#include    <stdlib.h>
+#include    <string.h>
+
+#include    "energy.h"
+
+#define CYCLES_PER_S    (SIM_CYCLES_PER_MS * 1000.0)
+
+const char *energy_name[ENERGY_LOADS] =
+{
+    "cpu48", "cpu16", "sleep", "wdt", "adc", "beeper",
+    "d1", "led2", "led3", "led4", "led5"
+};
+
+// Default currents (mA)
+static const double defaultCurrent[ENERGY_LOADS] =
+{
+    7.0,                            // cpu48: PIC16F1459 at 48 MHz
+    2.5,                            // cpu16: PIC16F1459 at 16 MHz
+    0.002,                          // sleep: PIC and board leakage
+    0.0005,                         // wdt: watchdog and LFINTOSC
+    0.25,                           // adc: converter on
+    1.5,                            // beeper: piezo driven at a tone
+    3.0,                            // d1
+    3.0, 3.0, 3.0, 3.0              // led2-led5
+};
+
+static energy_t *attached;          // Model attached to the hooks
+
+void energy_init(energy_t *e)
+{
+    *e = (energy_t){{0}};
+    memcpy(e->current, defaultCurrent, sizeof(e->current));
+    e->lastBeep = SIM_NEVER;
+    e->trisa = 0xFF;
+    e->trisc = 0xFF;
+}
+
+int energy_set(energy_t *e, const char *spec)
+{
+    const char *value = strchr(spec, '=');
+    char *end;
+    double mA;
+    int load;
+
+    if(value == NULL)
+    {
+        return(-1);
+    }
+    mA = strtod(value + 1, &end);
+    if(end == value + 1 || *end != '\0' || mA < 0)
+    {
+        return(-1);
+    }
+    if(value - spec == 4 && strncmp(spec, "leds", 4) == 0)
+    {
+        for(load = ENERGY_LED2; load != ENERGY_LED2 + 4; load++)
+        {
+            e->current[load] = mA;
+        }
+        return(0);
+    }
+    for(load = 0; load != ENERGY_LOADS; load++)
+    {
+        if(strlen(energy_name[load]) == (size_t)(value - spec) &&
+           strncmp(spec, energy_name[load], (size_t)(value - spec)) == 0)
+        {
+            e->current[load] = mA;
+            return(0);
+        }
+    }
+    return(-1);
+}
+
+void energy_parts(energy_t *e, int (*part)(void), const char **names, int parts)
+{
+    e->part = part;
+    e->partName = names;
+    e->parts = parts < ENERGY_PARTS ? parts : ENERGY_PARTS;
+    e->lastPart = part();
+}
+
+// Add on cycles of load to the totals, and to the part running.
+static void energy_add(energy_t *e, int load, uint64_t on)
+{
+    e->cycles[load] += on;
+    if(e->part)
+    {
+        e->partCycles[e->lastPart][load] += on;
+    }
+}
+
+void energy_sample(energy_t *e, uint64_t now)
+{
+    uint64_t dt = now - e->last;
+    uint64_t slept = sim_sleep_cycles - e->lastSleep;
+    uint64_t slow = sim_hfintosc_cycles - e->lastSlow;
+    uint8_t leds = e->latc & ~e->trisc;
+    int i;
+
+    if(slept > dt)
+    {
+        slept = dt;
+    }
+    if(slow > dt - slept)
+    {
+        slow = dt - slept;
+    }
+    energy_add(e, ENERGY_CPU48, dt - slept - slow);
+    energy_add(e, ENERGY_CPU16, slow);
+    energy_add(e, ENERGY_SLEEP, slept);
+    if(e->wdt)
+    {
+        energy_add(e, ENERGY_WDT, dt);
+    }
+    if(e->adc)
+    {
+        energy_add(e, ENERGY_ADC, dt);
+    }
+    if((e->trisa & 0x20) == 0 && (e->lata & 0x20) == 0)    // D1 is active-low
+    {
+        energy_add(e, ENERGY_D1, dt);
+    }
+    for(i = 0; i != 4; i++)
+    {
+        if(leds & (0x10 << i))
+        {
+            energy_add(e, ENERGY_LED2 + i, dt);
+        }
+    }
+    if(e->part)
+    {
+        e->partTime[e->lastPart] += dt;
+        i = e->part();
+        e->lastPart = (i >= 0 && i < e->parts) ? i : e->parts - 1;
+    }
+
+    e->last = now;
+    e->lastSleep = sim_sleep_cycles;
+    e->lastSlow = sim_hfintosc_cycles;
+    e->trisa = sim_sfr[SFR_TRISA];
+    e->trisc = sim_sfr[SFR_TRISC];
+    e->wdt = (sim_sfr[SFR_WDTCON] & 0x01) != 0;     // SWDTEN
+    e->adc = (sim_sfr[SFR_ADCON0] & 0x01) != 0;     // ADON
+}
+
+static uint64_t energy_input(void *ctx, uint64_t now)
+{
+    energy_sample(attached, now);
+    return(attached->nextInput ? attached->nextInput(ctx, now) : SIM_NEVER);
+}
+
+static void energy_output(void *ctx, uint64_t now, uint8_t lata, uint8_t latc)
+{
+    energy_t *e = attached;
+
+    energy_sample(e, now);
+    if((lata ^ e->lata) & 0x10)     // BEEPER edge
+    {
+        if(e->lastBeep != SIM_NEVER && now - e->lastBeep <= ENERGY_BEEP_GAP)
+        {
+            energy_add(e, ENERGY_BEEPER, now - e->lastBeep);
+        }
+        e->lastBeep = now;
+    }
+    e->lata = lata;
+    e->latc = latc;
+    if(e->nextOutput)
+    {
+        e->nextOutput(ctx, now, lata, latc);
+    }
+}
+
+static void energy_sleep(void *ctx, uint64_t now)
+{
+    energy_sample(attached, now);
+    if(attached->nextSleep)
+    {
+        attached->nextSleep(ctx, now);
+    }
+}
+
+void energy_attach(energy_t *e)
+{
+    attached = e;
+    e->last = sim_now;
+    e->lastSleep = sim_sleep_cycles;
+    e->lastSlow = sim_hfintosc_cycles;
+    e->nextInput = sim_hooks.input;
+    e->nextOutput = sim_hooks.output;
+    e->nextSleep = sim_hooks.sleep;
+    sim_hooks.input = energy_input;
+    sim_hooks.output = energy_output;
+    sim_hooks.sleep = energy_sleep;
+}
+
+double energy_mah(const energy_t *e, int load)
+{
+    double mAh = 0;
+    int i;
+
+    for(i = 0; i != ENERGY_LOADS; i++)
+    {
+        if(load == ENERGY_LOADS || load == i)
+        {
+            mAh += e->current[i] * (e->cycles[i] / CYCLES_PER_S) / 3600.0;
+        }
+    }
+    return(mAh);
+}
+
+double energy_part_mah(const energy_t *e, int part)
+{
+    double mAh = 0;
+    int i;
+
+    for(i = 0; i != ENERGY_LOADS; i++)
+    {
+        mAh += e->current[i] * (e->partCycles[part][i] / CYCLES_PER_S) / 3600.0;
+    }
+    return(mAh);
+}
+
+void energy_report(const energy_t *e, int games, FILE *out)
+{
+    double total = energy_mah(e, ENERGY_LOADS);
+    double seconds = e->last / CYCLES_PER_S;
+    int i;
+
+    fprintf(out, "load         current    on time    charge      share\n");
+    for(i = 0; i != ENERGY_LOADS; i++)
+    {
+        fprintf(out, "  %-8s %8.4f mA %8.1f s %9.5f mAh %5.1f%%\n",
+                energy_name[i], e->current[i], e->cycles[i] / CYCLES_PER_S,
+                energy_mah(e, i), total > 0 ? 100 * energy_mah(e, i) / total : 0.0);
+    }
+    if(e->part)
+    {
+        fprintf(out, "part           time      charge      share\n");
+        for(i = 0; i != e->parts; i++)
+        {
+            fprintf(out, "  %-10s %8.1f s %9.5f mAh %5.1f%%\n",
+                    e->partName[i], e->partTime[i] / CYCLES_PER_S, energy_part_mah(e, i),
+                    total > 0 ? 100 * energy_part_mah(e, i) / total : 0.0);
+        }
+    }
+    fprintf(out, "charge:        %.5f mAh in %.1f s (mean %.3f mA)\n",
+            total, seconds, seconds > 0 ? total * 3600 / seconds : 0.0);
+    if(games != 0)
+    {
+        fprintf(out, "per game:      %.5f mAh\n", total / games);
+    }
+}
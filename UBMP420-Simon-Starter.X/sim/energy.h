@@ -0,0 +1,156 @@
+/*==============================================================================
+ File: sim/energy.h
+ Date: October 16, 2026
+
+ Energy accounting model for the UBMP4.2 host simulator
+
+ Adds up how long each part of the board draws current during a simulated
+ run, and weighs each by a configurable current to give the charge used:
+
+   cpu48   processor awake on the 48 MHz PLL clock
+   cpu16   processor awake on the 16 MHz HFINTOSC, or waiting after a
+           wake-up for the PLL to lock
+   sleep   processor in SLEEP
+   wdt     watchdog running (the tick_sleep() wake-up timer)
+   adc     ADC on (ADCON0 ADON)
+   beeper  BEEPER toggling (edges no more than ENERGY_BEEP_GAP apart)
+   d1      power LED D1 lit (LATA5 low, driven)
+   led2-5  LEDs D2-D5 lit (LATC4-LATC7 high, driven)
+
+ The LED times follow the output pins edge by edge, so PWM dimming is
+ counted at its real duty cycle. Sleep and HFINTOSC time are exact (from
+ sim_sleep_cycles and sim_hfintosc_cycles); the watchdog and ADC settings
+ are read from the registers at every output change, sleep and input event,
+ and each interval between them is charged to the settings found at its
+ start.
+
+ A test program can also name the parts of the firmware the charge is
+ spent in (e.g. game states) with energy_parts(): the model asks which part
+ is running at every sample, and charges the interval that follows to it.
+
+ The default currents are rough figures for a PIC16F1459 at 3.3 V with LEDs
+ at about 3 mA - measure the board and set them with energy_set().
+==============================================================================*/
+
+#ifndef ENERGY_H
+#define ENERGY_H
+
+#include    <stdio.h>
+#include    <stdint.h>
+#include    <stdbool.h>
+
+#include    "sim.h"
+
+// Loads
+#define ENERGY_CPU48    0
+#define ENERGY_CPU16    1
+#define ENERGY_SLEEP    2
+#define ENERGY_WDT      3
+#define ENERGY_ADC      4
+#define ENERGY_BEEPER   5
+#define ENERGY_D1       6
+#define ENERGY_LED2     7           // LED2-LED5 are 7-10
+#define ENERGY_LOADS    11
+
+#define ENERGY_BEEP_GAP (10 * SIM_CYCLES_PER_MS)    // Longest beeper half-period
+#define ENERGY_PARTS    16          // Most firmware parts to break charge down by
+
+typedef struct
+{
+    double current[ENERGY_LOADS];   // Current drawn while each load is on (mA)
+    uint64_t cycles[ENERGY_LOADS];  // Time each load has been on (cycles)
+
+    // Board state at the last sample
+    uint64_t last;                  // Time of the last sample
+    uint64_t lastSleep;             // sim_sleep_cycles then
+    uint64_t lastSlow;              // sim_hfintosc_cycles then
+    uint64_t lastBeep;              // Time of the last BEEPER edge
+    uint8_t lata, latc;             // Output latches
+    uint8_t trisa, trisc;
+    bool wdt;                       // Watchdog on
+    bool adc;                       // ADC on
+
+    // Charge breakdown by firmware part (see energy_parts())
+    int (*part)(void);              // Part running now, or NULL
+    const char **partName;
+    int parts;
+    int lastPart;                   // Part running at the last sample
+    uint64_t partTime[ENERGY_PARTS];    // Time spent in each part (cycles)
+    uint64_t partCycles[ENERGY_PARTS][ENERGY_LOADS];    // Load on times
+
+    // Hooks called after the energy model's own
+    uint64_t (*nextInput)(void *, uint64_t);
+    void (*nextOutput)(void *, uint64_t, uint8_t, uint8_t);
+    void (*nextSleep)(void *, uint64_t);
+} energy_t;
+
+extern const char *energy_name[ENERGY_LOADS];
+
+/**
+ * Function: void energy_init(energy_t *e)
+ *
+ * Clear the totals and set the default currents.
+ */
+void energy_init(energy_t *);
+
+/**
+ * Function: int energy_set(energy_t *e, const char *spec)
+ *
+ * Set a load current from "name=mA" (a load name above, or "leds" for all
+ * of LED2-LED5). Returns 0, or -1 if spec isn't valid.
+ */
+int energy_set(energy_t *, const char *);
+
+/**
+ * Function: void energy_attach(energy_t *e)
+ *
+ * Start accounting the board's energy into e. Call after sim_reset() and
+ * after attaching the player: the hooks already set are still called.
+ * Only one energy model can be attached at a time.
+ */
+void energy_attach(energy_t *);
+
+/**
+ * Function: void energy_parts(energy_t *e, int (*part)(void),
+ *                             const char **names, int parts)
+ *
+ * Break the charge down by firmware part as well as by load. part() returns
+ * the part running now, from 0 to parts - 1 (at most ENERGY_PARTS), and
+ * names[] names them for the report. The model only samples when the board
+ * calls a hook, so a test program whose parts change without an output
+ * change should ask for input calls often enough to see them.
+ */
+void energy_parts(energy_t *, int (*)(void), const char **, int);
+
+/**
+ * Function: void energy_sample(energy_t *e, uint64_t now)
+ *
+ * Bring the totals up to time now (e.g. at the end of a run).
+ */
+void energy_sample(energy_t *, uint64_t);
+
+/**
+ * Function: double energy_mah(const energy_t *e, int load)
+ *
+ * Return the charge used by one load so far (mAh), or by all of them if
+ * load is ENERGY_LOADS.
+ */
+double energy_mah(const energy_t *, int);
+
+/**
+ * Function: double energy_part_mah(const energy_t *e, int part)
+ *
+ * Return the charge used by all loads while one firmware part was running.
+ */
+double energy_part_mah(const energy_t *, int);
+
+/**
+ * Function: void energy_report(const energy_t *e, int games, FILE *out)
+ *
+ * Print the current, on time, charge and share of each load, the time,
+ * charge and share of each firmware part if energy_parts() named them, and
+ * the total charge and mean charge per game.
+ */
+void energy_report(const energy_t *, int, FILE *);
+
+#endif
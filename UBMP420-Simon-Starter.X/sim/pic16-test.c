@@ -0,0 +1,579 @@
+/*==============================================================================
+ File: sim/pic16-test.c
+ Date: October 16, 2026
+
+ PIC16 emulator test
+
+ Assembles small programs straight into the simulated flash and runs them on
+ the emulator in pic16.c, checking the results left in data memory and the
+ timing of the outputs:
+
+   alu     arithmetic, logic, shift and skip instructions and their flags
+   memory  banks, common RAM, FSR indirect, linear and program memory reads,
+           RETLW tables, computed jumps and return stack overflow
+   delay   an XC8-style nested DECFSZ delay loop, timed exactly, with and
+           without loop skipping, at 48 MHz and at 16 MHz
+   tick    a 1 ms Timer2 interrupt and a main loop waiting for it, which
+           must leave exactly the same state with and without loop skipping
+   wake    SLEEP woken by a button press through interrupt-on-change
+   hex     the Intel HEX loader and its bootloader offset detection
+
+ and then reports the emulator's speed on a loop it can't skip.
+
+ Usage: pic16-test [-v]
+   -v        print the timing and speed figures of each test
+==============================================================================*/
+
+#include    <stdio.h>
+#include    <stdlib.h>
+#include    <string.h>
+#include    <time.h>
+
+#include    "sim.h"
+#include    "pic16.h"
+
+#define F           1               // Destination: file register
+#define W           0               // Destination: W
+
+#define RAM         0x20            // Bank 0 GPRs used by the programs
+#define COMMON      0x70            // Common RAM
+#define STATUS      0x03
+#define PCL         0x02
+
+static uint16_t org;                // Next program address
+static int failures = 0;
+static int verbose = 0;
+
+// Output edges on LATA4, recorded by the output() hook
+static uint64_t edges[8];
+static int edgeCount;
+
+// Assembler
+static void emit(uint16_t word)
+{
+    sim_flash[org++] = word;
+}
+
+static void op_f(uint16_t op, uint16_t f, int d)
+{
+    emit((uint16_t)((op << 8) | (d << 7) | (f & 0x7F)));
+}
+
+static void op_b(uint16_t op, uint16_t f, int bit)
+{
+    emit((uint16_t)((op << 8) | (bit << 7) | (f & 0x7F)));
+}
+
+static void addwf(uint16_t f, int d)  { op_f(0x07, f, d); }
+static void addwfc(uint16_t f, int d) { op_f(0x3D, f, d); }
+static void asrf(uint16_t f, int d)   { op_f(0x37, f, d); }
+static void clrf(uint16_t f)          { op_f(0x01, f, F); }
+static void comf(uint16_t f, int d)   { op_f(0x09, f, d); }
+static void decfsz(uint16_t f, int d) { op_f(0x0B, f, d); }
+static void incf(uint16_t f, int d)   { op_f(0x0A, f, d); }
+static void lslf(uint16_t f, int d)   { op_f(0x35, f, d); }
+static void lsrf(uint16_t f, int d)   { op_f(0x36, f, d); }
+static void movf(uint16_t f, int d)   { op_f(0x08, f, d); }
+static void movwf(uint16_t f)         { op_f(0x00, f, F); }
+static void rlf(uint16_t f, int d)    { op_f(0x0D, f, d); }
+static void rrf(uint16_t f, int d)    { op_f(0x0C, f, d); }
+static void subwf(uint16_t f, int d)  { op_f(0x02, f, d); }
+static void subwfb(uint16_t f, int d) { op_f(0x3B, f, d); }
+static void swapf(uint16_t f, int d)  { op_f(0x0E, f, d); }
+static void bcf(uint16_t f, int b)    { op_b(0x10, f, b); }
+static void bsf(uint16_t f, int b)    { op_b(0x14, f, b); }
+static void btfsc(uint16_t f, int b)  { op_b(0x18, f, b); }
+static void btfss(uint16_t f, int b)  { op_b(0x1C, f, b); }
+static void andlw(uint8_t k)          { emit(0x3900 | k); }
+static void movlw(uint8_t k)          { emit(0x3000 | k); }
+static void retlw(uint8_t k)          { emit(0x3400 | k); }
+static void sublw(uint8_t k)          { emit(0x3C00 | k); }
+static void movlb(uint16_t addr)      { emit(0x0020 | (addr >> 7)); }
+static void movlp(uint8_t k)          { emit(0x3180 | k); }
+static void bra(uint16_t to)          { emit(0x3200 | ((to - org - 1) & 0x1FF)); }
+static void call(uint16_t to)         { emit(0x2000 | (to & 0x7FF)); }
+static void gotoa(uint16_t to)        { emit(0x2800 | (to & 0x7FF)); }
+static void addfsr(int n, int k)      { emit((uint16_t)(0x3100 | (n << 6) | (k & 0x3F))); }
+static void moviw_inc(int n)          { emit((uint16_t)(0x0012 | (n << 2))); }  // moviw FSRn++
+static void movwi_inc(int n)          { emit((uint16_t)(0x001A | (n << 2))); }  // movwi FSRn++
+static void moviw_k(int n, int k)     { emit((uint16_t)(0x3F00 | (n << 6) | (k & 0x3F))); }
+static void retfie(void)              { emit(0x0009); }
+static void brw(void)                 { emit(0x000B); }
+static void sleep(void)               { emit(0x0063); }
+
+// Load FSRn with a 16-bit address.
+static void lfsr(int n, uint16_t addr)
+{
+    movlw(addr & 0xFF);
+    movwf(0x04 + 2 * n);
+    movlw(addr >> 8);
+    movwf(0x05 + 2 * n);
+}
+
+static void output_hook(void *ctx, uint64_t now, uint8_t lata, uint8_t latc)
+{
+    static uint8_t last;
+
+    (void)ctx;
+    (void)latc;
+    if(((lata ^ last) & 0x10) && edgeCount < 8)
+    {
+        edges[edgeCount++] = now;
+    }
+    last = lata;
+}
+
+// Button press on SW2 (RB4) at 10 ms, released 50 ms later.
+static uint64_t input_hook(void *ctx, uint64_t now)
+{
+    (void)ctx;
+    if(now < 60 * SIM_CYCLES_PER_MS)
+    {
+        sim_set_pins(1, 0x10, 0x00);
+        return(60 * SIM_CYCLES_PER_MS);
+    }
+    sim_set_pins(1, 0x10, 0x10);
+    return(SIM_NEVER);
+}
+
+// Start a new program at address 0 in blank flash.
+static void program(void)
+{
+    sim_flash_blank();
+    org = 0;
+}
+
+// Run the program from a power-on reset. Returns the halt reason.
+static int run(uint64_t limit)
+{
+    int halt;
+
+    sim_reset();
+    sim_hooks = (sim_hooks_t){0};
+    sim_hooks.output = output_hook;
+    sim_limit = limit;
+    edgeCount = 0;
+    pic16_offset = 0;
+    halt = sim_run(pic16_run);
+    sim_limit = SIM_NEVER;
+    return(halt);
+}
+
+static void expect(const char *test, const char *what, unsigned long long got,
+                   unsigned long long want)
+{
+    if(got != want)
+    {
+        fprintf(stderr, "%s: %s is 0x%llX, expected 0x%llX\n", test, what, got, want);
+        failures++;
+    }
+}
+
+static void test_alu(void)
+{
+    uint16_t loop;
+
+    program();
+    movlw(0x3C);                    // 0x3C + 0xC5 = 0x101: C, DC
+    movwf(COMMON);
+    movlw(0xC5);
+    addwf(COMMON, W);
+    movwf(RAM + 0);
+    movf(STATUS, W);
+    andlw(0x07);
+    movwf(RAM + 1);
+    movlw(0x10);                    // 0x10 - 0x20 = 0xF0: borrow, no DC borrow
+    movwf(COMMON);
+    movlw(0x20);
+    subwf(COMMON, W);
+    movwf(RAM + 2);
+    movf(STATUS, W);
+    andlw(0x07);
+    movwf(RAM + 3);
+    movlw(0xFF);                    // 0x12FF + 1 with ADDWFC carry
+    movwf(RAM + 4);
+    movlw(0x12);
+    movwf(RAM + 5);
+    movlw(1);
+    addwf(RAM + 4, F);
+    movlw(0);
+    addwfc(RAM + 5, F);
+    movlw(0x00);                    // 0x1300 - 1 with SUBWFB borrow
+    movwf(RAM + 6);
+    movlw(0x13);
+    movwf(RAM + 7);
+    movlw(1);
+    subwf(RAM + 6, F);
+    movlw(0);
+    subwfb(RAM + 7, F);
+    movlw(0x05);                    // 3 - 5
+    sublw(0x03);
+    movwf(RAM + 8);
+    movlw(0x81);                    // Shifts and rotates through carry
+    movwf(RAM + 9);
+    asrf(RAM + 9, F);               // 0xC0, C = 1
+    rlf(RAM + 9, F);                // 0x81, C = 1
+    lsrf(RAM + 9, W);               // W = 0x40, C = 1
+    movwf(RAM + 10);
+    lslf(RAM + 9, F);               // 0x02, C = 1
+    rrf(RAM + 9, F);                // 0x81, C = 0
+    movlw(0xA5);
+    movwf(RAM + 11);
+    swapf(RAM + 11, F);             // 0x5A
+    comf(RAM + 11, W);              // 0xA5
+    movwf(RAM + 12);
+    movlw(3);                       // DECFSZ loop runs 3 times
+    movwf(RAM + 13);
+    clrf(RAM + 14);
+    loop = org;
+    incf(RAM + 14, F);
+    decfsz(RAM + 13, F);
+    bra(loop);
+    clrf(RAM + 15);                 // Bit tests: two skips, one increment
+    movlw(0x80);
+    movwf(COMMON);
+    btfss(COMMON, 7);
+    incf(RAM + 15, F);
+    btfsc(COMMON, 6);
+    incf(RAM + 15, F);
+    btfsc(COMMON, 7);
+    incf(RAM + 15, F);
+    sleep();
+
+    expect("alu", "halt", run(SIM_NEVER), SIM_HALT_ASLEEP);
+    expect("alu", "ADDWF", sim_sfr[RAM + 0], 0x01);
+    expect("alu", "ADDWF flags", sim_sfr[RAM + 1], 0x03);
+    expect("alu", "SUBWF", sim_sfr[RAM + 2], 0xF0);
+    expect("alu", "SUBWF flags", sim_sfr[RAM + 3], 0x02);
+    expect("alu", "ADDWFC", sim_sfr[RAM + 4] | (sim_sfr[RAM + 5] << 8), 0x1300);
+    expect("alu", "SUBWFB", sim_sfr[RAM + 6] | (sim_sfr[RAM + 7] << 8), 0x12FF);
+    expect("alu", "SUBLW", sim_sfr[RAM + 8], 0xFE);
+    expect("alu", "shifts", sim_sfr[RAM + 9], 0x81);
+    expect("alu", "LSRF", sim_sfr[RAM + 10], 0x40);
+    expect("alu", "SWAPF", sim_sfr[RAM + 11], 0x5A);
+    expect("alu", "COMF", sim_sfr[RAM + 12], 0xA5);
+    expect("alu", "DECFSZ count", sim_sfr[RAM + 13], 0);
+    expect("alu", "DECFSZ loops", sim_sfr[RAM + 14], 3);
+    expect("alu", "bit tests", sim_sfr[RAM + 15], 1);
+}
+
+static void test_memory(void)
+{
+    uint16_t table, data, recurse;
+    int i;
+
+    program();
+    movlw(0x11);                    // Bank 2 GPR and common RAM through bank 5
+    movlb(0x100);
+    movwf(0x20);
+    movwf(COMMON + 1);
+    movlb(0x280);
+    movf(COMMON + 1, W);
+    movlb(0);
+    addwf(COMMON + 1, W);
+    movwf(RAM + 0);                 // 0x22
+    lfsr(0, 0x204E);                // Linear memory crosses from bank 0 to 1
+    for(i = 0; i != 4; i++)
+    {
+        movlw((uint8_t)(0xA0 + i));
+        movwi_inc(0);
+    }
+    moviw_k(0, -1);                 // W = 0xA3 from 0xA1 (bank 1)
+    movwf(RAM + 1);
+    lfsr(1, 0x8000 + 0x100);        // Program memory low bytes
+    moviw_inc(1);
+    movwf(RAM + 2);
+    moviw_inc(1);
+    movwf(RAM + 3);
+    addfsr(1, -2);
+    movf(0x06, W);                  // FSR1L back at 0x00
+    movwf(RAM + 4);
+    movlw(2);                       // RETLW table through BRW
+    call(0x080);
+    movwf(RAM + 5);
+    movlp(0);                       // Computed jump through PCL
+    movlw(0x90);
+    movwf(PCL);
+    sleep();
+
+    org = 0x080;
+    table = org;
+    brw();
+    retlw(0x55);
+    retlw(0x66);
+    retlw(0x77);
+    (void)table;
+
+    org = 0x090;
+    movlw(0x99);
+    movwf(RAM + 6);
+    sleep();
+
+    org = 0x100;
+    data = org;
+    emit(0x3F12);
+    emit(0x0034);
+    (void)data;
+
+    expect("memory", "halt", run(SIM_NEVER), SIM_HALT_ASLEEP);
+    expect("memory", "bank 2", sim_sfr[0x120], 0x11);
+    expect("memory", "common RAM", sim_sfr[RAM + 0], 0x22);
+    expect("memory", "linear bank 0", sim_sfr[0x6E] | (sim_sfr[0x6F] << 8), 0xA1A0);
+    expect("memory", "linear bank 1", sim_sfr[0xA0] | (sim_sfr[0xA1] << 8), 0xA3A2);
+    expect("memory", "MOVIW k", sim_sfr[RAM + 1], 0xA3);
+    expect("memory", "program memory", sim_sfr[RAM + 2] | (sim_sfr[RAM + 3] << 8), 0x3412);
+    expect("memory", "ADDFSR", sim_sfr[RAM + 4], 0x00);
+    expect("memory", "RETLW table", sim_sfr[RAM + 5], 0x77);
+    expect("memory", "PCL jump", sim_sfr[RAM + 6], 0x99);
+
+    program();                      // Unbounded recursion
+    recurse = org;
+    call(recurse);
+    expect("memory", "stack overflow halt", run(SIM_NEVER), SIM_HALT_RESET);
+    expect("memory", "stack errors", pic16_stats.stackErrors, 1);
+}
+
+// Delay loop as XC8 generates it: outer count 100, inner count 200 then 256.
+static uint64_t delay_run(bool skip, bool slow)
+{
+    uint16_t loop;
+
+    program();
+    if(slow)
+    {
+        movlw(0xFE);                // 16 MHz HFINTOSC, no PLL
+        movlb(SFR_OSCCON);
+        movwf(SFR_OSCCON);
+    }
+    movlb(SFR_TRISA);
+    bcf(SFR_TRISA, 4);
+    movlb(SFR_LATA);
+    bsf(SFR_LATA, 4);
+    movlw(100);
+    movwf(COMMON);
+    movlw(200);
+    movwf(COMMON + 1);
+    loop = org;
+    decfsz(COMMON + 1, F);
+    bra(loop);
+    decfsz(COMMON, F);
+    bra(loop);
+    bcf(SFR_LATA, 4);
+    sleep();
+
+    pic16_skip = skip;
+    expect("delay", "halt", run(SIM_NEVER), SIM_HALT_ASLEEP);
+    pic16_skip = true;
+    expect("delay", "edges", (unsigned)edgeCount, 2);
+    return(edges[1] - edges[0]);
+}
+
+static void test_delay(void)
+{
+    // BSF, 4 loads, 199 inner passes and the skip, then 99 x (outer pass,
+    // 255 inner passes and the skip) and the outer skip
+    uint64_t want = 1 + 4 + (199 * 3 + 2) + 99 * (3 + 255 * 3 + 2) + 2;
+    uint64_t fast = delay_run(true, false);
+    uint64_t skipped = pic16_stats.skipped;
+
+    expect("delay", "48 MHz cycles", fast, want);
+    expect("delay", "48 MHz cycles, no skipping", delay_run(false, false), want);
+    expect("delay", "16 MHz cycles", delay_run(true, true), 3 * want);
+    if(skipped == 0)
+    {
+        fprintf(stderr, "delay: loop not skipped\n");
+        failures++;
+    }
+    if(verbose)
+    {
+        printf("  delay: %llu cycles, %llu instructions skipped\n",
+               (unsigned long long)fast, (unsigned long long)skipped);
+    }
+}
+
+// Timer2 1 ms tick. The ISR counts ticks and sets a flag; the main loop
+// waits for the flag, clears it and counts the ticks it saw.
+static void tick_program(void)
+{
+    uint16_t loop;
+
+    program();
+    gotoa(0x010);
+    org = 0x004;                    // Interrupt vector
+    movlb(SFR_PIR1);
+    bcf(SFR_PIR1, 1);               // TMR2IF
+    incf(COMMON, F);
+    bsf(COMMON + 1, 0);
+    retfie();
+
+    org = 0x010;
+    clrf(COMMON);
+    clrf(COMMON + 1);
+    clrf(COMMON + 2);
+    movlb(SFR_PR2);
+    movlw(149);
+    movwf(SFR_PR2);
+    movlw(0x26);                    // 1:5 postscaler, on, 1:16 prescaler
+    movwf(SFR_T2CON);
+    movlb(SFR_PIE1);
+    bsf(SFR_PIE1, 1);               // TMR2IE
+    movlw(0xC0);                    // GIE, PEIE
+    movwf(0x0B);
+    loop = org;
+    btfss(COMMON + 1, 0);
+    bra(loop);
+    bcf(COMMON + 1, 0);
+    incf(COMMON + 2, F);
+    bra(loop);
+}
+
+static void test_tick(void)
+{
+    uint8_t ticks, seen;
+    pic16_stats_t fast;
+
+    tick_program();
+    expect("tick", "halt", run(100 * SIM_CYCLES_PER_MS + 100), SIM_HALT_LIMIT);
+    ticks = sim_sfr[COMMON];
+    seen = sim_sfr[COMMON + 2];
+    fast = pic16_stats;
+    expect("tick", "ticks", ticks, 100);
+    expect("tick", "ticks seen", seen, 100);
+
+    pic16_skip = false;
+    tick_program();
+    expect("tick", "halt, no skipping", run(100 * SIM_CYCLES_PER_MS + 100), SIM_HALT_LIMIT);
+    pic16_skip = true;
+    expect("tick", "ticks, no skipping", sim_sfr[COMMON], ticks);
+    expect("tick", "ticks seen, no skipping", sim_sfr[COMMON + 2], seen);
+    expect("tick", "interrupts, no skipping", pic16_stats.interrupts, fast.interrupts);
+    expect("tick", "instructions, no skipping", pic16_stats.instructions,
+           fast.instructions + fast.skipped);
+    if(verbose)
+    {
+        printf("  tick: %llu instructions, %llu skipped, %llu board updates\n",
+               (unsigned long long)fast.instructions,
+               (unsigned long long)fast.skipped, (unsigned long long)fast.syncs);
+    }
+}
+
+static void test_wake(void)
+{
+    program();
+    gotoa(0x010);
+    org = 0x004;                    // Interrupt vector: clear the IOC flags
+    movlb(SFR_IOCBF);
+    clrf(SFR_IOCBF);
+    incf(COMMON, F);
+    retfie();
+
+    org = 0x010;
+    clrf(COMMON);
+    movlb(SFR_IOCBN);
+    movlw(0x10);                    // Falling edge on RB4 (SW2)
+    movwf(SFR_IOCBN);
+    movlw(0x88);                    // GIE, IOCIE
+    movwf(0x0B);
+    sleep();
+    incf(COMMON, F);
+    sleep();
+
+    sim_reset();
+    sim_hooks = (sim_hooks_t){0};
+    sim_hooks.input = input_hook;
+    sim_schedule_input(10 * SIM_CYCLES_PER_MS);
+    pic16_offset = 0;
+    expect("wake", "halt", sim_run(pic16_run), SIM_HALT_ASLEEP);
+    expect("wake", "interrupt and wake", sim_sfr[COMMON], 2);
+    if(sim_sleep_cycles < 10 * SIM_CYCLES_PER_MS)
+    {
+        fprintf(stderr, "wake: woke before the press\n");
+        failures++;
+    }
+}
+
+static void test_hex(void)
+{
+    const char *path = "build/pic16-test.hex";
+    FILE *file = fopen(path, "w");
+
+    if(file == NULL)
+    {
+        fprintf(stderr, "hex: can't write %s\n", path);
+        failures++;
+        return;
+    }
+    fputs(":020000040000FA\n", file);
+    fputs(":041000001230A0000A\n", file);    // 0x800: movlw 0x12, movwf 0x20
+    fputs(":020000040001F9\n", file);
+    fputs(":04000E00E43FFF1FAD\n", file);    // Configuration words
+    fputs(":00000001FF\n", file);
+    fclose(file);
+
+    expect("hex", "words", (unsigned)pic16_load_hex(path), 2);
+    expect("hex", "offset", pic16_offset, 0x800);
+    expect("hex", "word 0x800", sim_flash[0x800], 0x3012);
+    expect("hex", "word 0x801", sim_flash[0x801], 0x00A0);
+    expect("hex", "word 0x000", sim_flash[0x000], PIC16_BLANK);
+
+    file = fopen(path, "w");
+    fputs(":041000001230A0000B\n", file);    // Bad checksum
+    fclose(file);
+    expect("hex", "bad record", (unsigned)pic16_load_hex(path), (unsigned)-1);
+    remove(path);
+}
+
+// A counting loop the emulator has to run instruction by instruction.
+static void test_speed(void)
+{
+    uint16_t loop;
+    struct timespec t0, t1;
+    double wall;
+
+    program();
+    loop = org;
+    incf(COMMON, F);
+    btfsc(STATUS, 2);
+    incf(COMMON + 1, F);
+    movf(COMMON + 1, W);
+    addwf(COMMON + 2, F);
+    gotoa(loop);
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    run(1000 * SIM_CYCLES_PER_MS);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    wall = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9;
+    printf("speed:  %llu instructions in %.3f s (%.0f MIPS, %.0fx real time)\n",
+           (unsigned long long)pic16_stats.instructions, wall,
+           pic16_stats.instructions / wall / 1e6, 1.0 / wall);
+}
+
+int main(int argc, char **argv)
+{
+    int i;
+
+    for(i = 1; i < argc; i++)
+    {
+        if(argv[i][0] == '-' && argv[i][1] == 'v')
+            verbose = 1;
+        else
+        {
+            fprintf(stderr, "usage: %s [-v]\n", argv[0]);
+            return(2);
+        }
+    }
+
+    test_alu();
+    test_memory();
+    test_delay();
+    test_tick();
+    test_wake();
+    test_hex();
+    test_speed();
+    if(failures != 0)
+    {
+        fprintf(stderr, "%d PIC16 emulator test failure(s)\n", failures);
+        return(1);
+    }
+    return(0);
+}
@@ -0,0 +1,1068 @@
+/*==============================================================================
+ File: sim/pic16.c
+ Date: October 16, 2026
+
+ Enhanced mid-range PIC16 (PIC16F1459) instruction set emulator
+
+ Program memory is decoded once into code[] (and again after a self-write),
+ and run() executes the decoded instructions in a switch. Data memory
+ addresses are looked up in memMap[], which sends GPR accesses straight to
+ sim_sfr[], core register accesses (INDFn, PCL, STATUS, FSRs, BSR, WREG,
+ PCLATH) to the CPU registers, and SFR accesses through the board model in
+ sim.c. The board is brought up to the CPU's time before every SFR access,
+ and picks up each SFR write straight after it, so what the peripherals see
+ is exactly timed. Between SFR accesses the board is only updated when its
+ next event falls due.
+
+ Instruction cycles are counted in the simulator's 12 MHz cycles, so one
+ instruction cycle is 1 cycle at 48 MHz, 3 at 16 MHz, and so on.
+==============================================================================*/
+
+#include    <stdio.h>
+#include    <string.h>
+
+#include    "sim.h"
+#include    "pic16.h"
+
+pic16_stats_t pic16_stats;
+uint16_t pic16_offset = 0;
+bool pic16_skip = true;
+
+// Decoded instructions
+enum
+{
+    OP_NOP, OP_ADDWF, OP_ADDWFC, OP_ANDWF, OP_ASRF, OP_LSLF, OP_LSRF, OP_CLRF,
+    OP_CLRW, OP_COMF, OP_DECF, OP_DECFSZ, OP_INCF, OP_INCFSZ, OP_IORWF,
+    OP_MOVF, OP_MOVWF, OP_RLF, OP_RRF, OP_SUBWF, OP_SUBWFB, OP_SWAPF,
+    OP_XORWF, OP_BCF, OP_BSF, OP_BTFSC, OP_BTFSS, OP_ADDLW, OP_ANDLW,
+    OP_IORLW, OP_MOVLB, OP_MOVLP, OP_MOVLW, OP_SUBLW, OP_XORLW, OP_BRA,
+    OP_BRW, OP_CALL, OP_CALLW, OP_GOTO, OP_RETFIE, OP_RETLW, OP_RETURN,
+    OP_CLRWDT, OP_RESET, OP_SLEEP, OP_ADDFSR, OP_MOVIW, OP_MOVWI, OP_MOVIWK,
+    OP_MOVWIK, OP_OPTION, OP_TRIS
+};
+
+typedef struct
+{
+    uint8_t op;                     // OP_ code
+    uint8_t d;                      // Destination (1 = file), bit mask or FSR
+    uint16_t k;                     // File address, literal, offset or mode
+} insn_t;
+
+// CPU registers compared by the waiting loop check
+typedef struct
+{
+    uint16_t fsr[2];
+    uint8_t w;
+    uint8_t status;
+    uint8_t bsr;
+    uint8_t pclath;
+    uint8_t sp;                     // Return stack entries in use
+    uint8_t pad;
+} regs_t;
+
+// STATUS bits
+#define ST_C        0x01
+#define ST_DC       0x02
+#define ST_Z        0x04
+#define ST_PD       0x08
+#define ST_TO       0x10
+
+// memMap[] entries: physical sim_sfr[] index, or core register number
+#define MAP_RAM     0x0000
+#define MAP_CORE    0x4000
+#define MAP_SFR     0x8000
+#define MAP_INDEX   0x0FFF
+
+// Interrupt context shadow registers (bank 31)
+#define SHAD_STATUS 0xFE4
+#define SHAD_WREG   0xFE5
+#define SHAD_BSR    0xFE6
+#define SHAD_PCLATH 0xFE7
+#define SHAD_FSR0L  0xFE8
+
+#define LINEAR_BASE 0x2000          // FSR linear view of the GPR banks
+#define LINEAR_SIZE (31 * 80)
+#define FLASH_BASE  0x8000          // FSR view of program memory
+
+static insn_t code[SIM_FLASH_WORDS];
+static uint16_t memMap[SIM_SFR_SIZE];
+static regs_t cpu;
+static uint16_t pc;                 // Address of the next instruction
+static uint16_t stack[PIC16_STACK];
+static uint64_t now;                // CPU virtual time (ahead of sim_now)
+static uint64_t nextEvent;          // Time of the next board event
+static uint32_t cpi;                // Simulator cycles per instruction cycle
+static bool irqReady;               // GIE set and an interrupt pending
+static bool dirty;                  // Memory written or timer read since the
+                                    // last waiting loop check
+
+// Waiting loop check: state at the last backward branch
+static uint16_t loopPC;
+static regs_t loopRegs;
+static uint64_t loopTime;
+static uint64_t loopCount;
+
+static void sfr_write(uint16_t, uint8_t);
+
+// Build the data memory map. Each of the 32 banks has the core registers at
+// 0x00-0x0B, SFRs at 0x0C-0x1F, GPRs at 0x20-0x6F and common RAM at
+// 0x70-0x7F (the same 16 bytes in every bank).
+static void map_init(void)
+{
+    uint16_t addr;
+
+    for(addr = 0; addr != SIM_SFR_SIZE; addr++)
+    {
+        uint8_t offset = addr & 0x7F;
+
+        if(offset < 0x0B)
+        {
+            memMap[addr] = MAP_CORE | offset;
+        }
+        else if(offset == 0x0B)
+        {
+            memMap[addr] = MAP_SFR | SFR_INTCON;
+        }
+        else if(offset < 0x20)
+        {
+            memMap[addr] = MAP_SFR | addr;
+        }
+        else if(offset >= 0x70)
+        {
+            memMap[addr] = MAP_RAM | offset;
+        }
+        else
+        {
+            memMap[addr] = MAP_RAM | addr;
+        }
+    }
+}
+
+static int16_t sign_extend(uint16_t value, int bits)
+{
+    return((int16_t)(value << (16 - bits)) >> (16 - bits));
+}
+
+// Decode the program word at addr.
+static void decode(uint16_t addr)
+{
+    uint16_t word = sim_flash[addr] & 0x3FFF;
+    insn_t *in = &code[addr];
+    static const uint8_t byteOps[16] =
+    {
+        OP_MOVWF, OP_CLRF, OP_SUBWF, OP_DECF, OP_IORWF, OP_ANDWF, OP_XORWF,
+        OP_ADDWF, OP_MOVF, OP_COMF, OP_INCF, OP_DECFSZ, OP_RRF, OP_RLF,
+        OP_SWAPF, OP_INCFSZ
+    };
+    static const uint8_t literalOps[16] =
+    {
+        OP_MOVLW, OP_ADDFSR, OP_BRA, OP_BRA, OP_RETLW, OP_LSLF, OP_LSRF,
+        OP_ASRF, OP_IORLW, OP_ANDLW, OP_XORLW, OP_SUBWFB, OP_SUBLW, OP_ADDWFC,
+        OP_ADDLW, OP_MOVIWK
+    };
+    static const uint8_t bitOps[4] = {OP_BCF, OP_BSF, OP_BTFSC, OP_BTFSS};
+
+    in->d = (word >> 7) & 0x01;
+    in->k = word & 0x7F;
+    switch(word >> 12)
+    {
+    case 0:                         // Byte-oriented file operations
+        in->op = byteOps[(word >> 8) & 0x0F];
+        if(word >= 0x0100 || in->d)
+        {
+            if(in->op == OP_CLRF && !in->d)
+            {
+                in->op = OP_CLRW;
+            }
+            break;
+        }
+        in->op = OP_NOP;            // 00 0000 0xxx xxxx: control operations
+        if(word == 0x0001)
+            in->op = OP_RESET;
+        else if(word == 0x0008)
+            in->op = OP_RETURN;
+        else if(word == 0x0009)
+            in->op = OP_RETFIE;
+        else if(word == 0x000A)
+            in->op = OP_CALLW;
+        else if(word == 0x000B)
+            in->op = OP_BRW;
+        else if(word >= 0x0010 && word <= 0x001F)
+        {
+            in->op = (word & 0x08) ? OP_MOVWI : OP_MOVIW;
+            in->d = (word >> 2) & 0x01;
+            in->k = word & 0x03;
+        }
+        else if(word >= 0x0020 && word <= 0x003F)
+        {
+            in->op = OP_MOVLB;
+            in->k = word & 0x1F;
+        }
+        else if(word == 0x0062)
+            in->op = OP_OPTION;
+        else if(word == 0x0063)
+            in->op = OP_SLEEP;
+        else if(word == 0x0064)
+            in->op = OP_CLRWDT;
+        else if(word >= 0x0065 && word <= 0x0067)
+        {
+            in->op = OP_TRIS;
+            in->k = word & 0x07;
+        }
+        break;
+
+    case 1:                         // Bit-oriented file operations
+        in->op = bitOps[(word >> 10) & 0x03];
+        in->d = (uint8_t)(1 << ((word >> 7) & 0x07));
+        break;
+
+    case 2:                         // CALL and GOTO
+        in->op = (word & 0x0800) ? OP_GOTO : OP_CALL;
+        in->k = word & 0x07FF;
+        break;
+
+    case 3:                         // Literal and FSR operations
+        in->op = literalOps[(word >> 8) & 0x0F];
+        switch(in->op)
+        {
+        case OP_ADDFSR:
+            if(word & 0x80)
+            {
+                in->op = OP_MOVLP;
+                in->k = word & 0x7F;
+            }
+            else
+            {
+                in->d = (word >> 6) & 0x01;
+                in->k = (uint16_t)sign_extend(word & 0x3F, 6);
+            }
+            break;
+        case OP_BRA:
+            in->k = (uint16_t)sign_extend(word & 0x1FF, 9);
+            break;
+        case OP_MOVIWK:
+            in->op = (word & 0x80) ? OP_MOVWIK : OP_MOVIWK;
+            in->d = (word >> 6) & 0x01;
+            in->k = (uint16_t)sign_extend(word & 0x3F, 6);
+            break;
+        case OP_LSLF:
+        case OP_LSRF:
+        case OP_ASRF:
+        case OP_SUBWFB:
+        case OP_ADDWFC:
+            break;                  // File operations
+        default:
+            in->k = word & 0xFF;
+            break;
+        }
+        break;
+    }
+}
+
+static void decode_all(void)
+{
+    uint16_t addr;
+
+    for(addr = 0; addr != SIM_FLASH_WORDS; addr++)
+    {
+        decode(addr);
+    }
+}
+
+// Simulator cycles per instruction cycle at the clock selected by OSCCON
+// (FOSC = INTOSC in the configuration words, so SCS = 00 runs from the PLL
+// once it has locked, and from HFINTOSC until then).
+static uint32_t clock_cpi(void)
+{
+    static const uint16_t ircfCpi[16] =   // IRCF<3:0>: 31 kHz to 16 MHz
+    {
+        1548, 1548, 1548, 1536, 768, 384, 192, 96,
+        384, 192, 96, 48, 24, 12, 6, 3
+    };
+    uint8_t osccon = sim_sfr[SFR_OSCCON];
+
+    if((osccon & 0x03) == 0x00 && (sim_sfr[SFR_OSCSTAT] & 0x40))
+    {
+        return(1);                  // 3x PLL: 48 MHz
+    }
+    return(ircfCpi[(osccon >> 2) & 0x0F]);
+}
+
+// Bring the board up to the CPU's time and pick up any SFR writes. Crossing
+// a board event may change any register, so it ends a waiting loop pass.
+static void board_sync(void)
+{
+    if(now >= nextEvent)
+    {
+        dirty = true;
+    }
+    nextEvent = sim_cpu_sync(now);
+    if(sim_now > now)               // Board stalled the CPU (flash write)
+    {
+        now = sim_now;
+    }
+    cpi = clock_cpi();              // The PLL may have locked
+    irqReady = (sim_sfr[SFR_INTCON] & 0x80) && sim_cpu_irq();
+    pic16_stats.syncs++;
+}
+
+static uint8_t sfr_read(uint16_t index)
+{
+    if(sim_now < now)
+    {
+        board_sync();
+    }
+    if(index == SFR_TMR0 || index == SFR_TMR1L || index == SFR_TMR1H ||
+       index == SFR_TMR2)
+    {
+        dirty = true;               // Timers count between events
+    }
+    return(sim_sfr[index]);
+}
+
+// Map an FSR value to a data memory address, or -1 for program memory or
+// unimplemented memory.
+static int fsr_data(uint16_t fsr)
+{
+    if(fsr < SIM_SFR_SIZE)
+    {
+        return(fsr);
+    }
+    if(fsr >= LINEAR_BASE && fsr < LINEAR_BASE + LINEAR_SIZE)
+    {
+        uint16_t n = fsr - LINEAR_BASE;
+
+        return(((n / 80) << 7) | (0x20 + n % 80));
+    }
+    return(-1);
+}
+
+static uint8_t core_read(uint8_t reg);
+
+static uint8_t ind_read(uint16_t fsr)
+{
+    int addr = fsr_data(fsr);
+    uint16_t map;
+
+    if(addr < 0)
+    {
+        if(fsr >= FLASH_BASE && fsr - FLASH_BASE < SIM_FLASH_WORDS)
+        {
+            return(sim_flash[fsr - FLASH_BASE] & 0xFF);
+        }
+        return(0);
+    }
+    map = memMap[addr];
+    if(map & MAP_SFR)
+    {
+        return(sfr_read(map & MAP_INDEX));
+    }
+    if(map & MAP_CORE)
+    {
+        return((map & MAP_INDEX) <= 1 ? 0 : core_read(map & MAP_INDEX));
+    }
+    return(sim_sfr[map]);
+}
+
+static void core_write(uint8_t reg, uint8_t value);
+
+static void ind_write(uint16_t fsr, uint8_t value)
+{
+    int addr = fsr_data(fsr);
+    uint16_t map;
+
+    dirty = true;
+    if(addr < 0)
+    {
+        return;                     // Program memory is read-only here
+    }
+    map = memMap[addr];
+    if(map & MAP_SFR)
+    {
+        sfr_write(map & MAP_INDEX, value);
+    }
+    else if(map & MAP_CORE)
+    {
+        if((map & MAP_INDEX) > 1)
+        {
+            core_write(map & MAP_INDEX, value);
+        }
+    }
+    else
+    {
+        sim_sfr[map] = value;
+    }
+}
+
+static uint8_t core_read(uint8_t reg)
+{
+    switch(reg)
+    {
+    case 0: return(ind_read(cpu.fsr[0]));
+    case 1: return(ind_read(cpu.fsr[1]));
+    case 2: return(pc & 0xFF);
+    case 3: return(cpu.status);
+    case 4: return(cpu.fsr[0] & 0xFF);
+    case 5: return(cpu.fsr[0] >> 8);
+    case 6: return(cpu.fsr[1] & 0xFF);
+    case 7: return(cpu.fsr[1] >> 8);
+    case 8: return(cpu.bsr);
+    case 9: return(cpu.w);
+    default: return(cpu.pclath);
+    }
+}
+
+static void core_write(uint8_t reg, uint8_t value)
+{
+    switch(reg)
+    {
+    case 0: ind_write(cpu.fsr[0], value); break;
+    case 1: ind_write(cpu.fsr[1], value); break;
+    case 2:                         // Computed jump
+        pc = (uint16_t)((cpu.pclath << 8) | value);
+        now += cpi;                 // Takes a second cycle
+        break;
+    case 3:                         // nTO and nPD are read-only
+        cpu.status = (cpu.status & (ST_TO | ST_PD)) | (value & 0x07);
+        break;
+    case 4: cpu.fsr[0] = (cpu.fsr[0] & 0xFF00) | value; break;
+    case 5: cpu.fsr[0] = (uint16_t)((cpu.fsr[0] & 0x00FF) | (value << 8)); break;
+    case 6: cpu.fsr[1] = (cpu.fsr[1] & 0xFF00) | value; break;
+    case 7: cpu.fsr[1] = (uint16_t)((cpu.fsr[1] & 0x00FF) | (value << 8)); break;
+    case 8: cpu.bsr = value & 0x1F; break;
+    case 9: cpu.w = value; break;
+    default: cpu.pclath = value & 0x7F; break;
+    }
+}
+
+// Self-read or self-write of program memory. The CPU stalls while the board
+// carries it out, so interrupts wait until it is done.
+static void flash_access(uint8_t pmcon1)
+{
+    uint8_t gie = sim_sfr[SFR_INTCON] & 0x80;
+
+    sim_sfr[SFR_INTCON] &= ~0x80;
+    sim_nop();
+    sim_sfr[SFR_INTCON] |= gie;
+    if(pmcon1 & 0x02)
+    {
+        decode_all();
+    }
+}
+
+static void sfr_write(uint16_t index, uint8_t value)
+{
+    if(sim_now < now)
+    {
+        board_sync();
+    }
+    if(index >= SFR_PORTA && index <= SFR_PORTC)
+    {
+        index += SFR_LATA - SFR_PORTA;  // Port writes go to the latches
+    }
+    sim_sfr[index] = value;
+    if(index == SFR_PMCON1 && (value & 0x03))
+    {
+        flash_access(value);
+    }
+    else if(index == SFR_OSCCON)
+    {
+        cpi = clock_cpi();
+    }
+    board_sync();
+    dirty = true;
+}
+
+// Read and write file register f in the current bank.
+static inline uint8_t file_read(uint8_t f)
+{
+    uint16_t map = memMap[(cpu.bsr << 7) | f];
+
+    if(map & (MAP_SFR | MAP_CORE))
+    {
+        return((map & MAP_SFR) ? sfr_read(map & MAP_INDEX) : core_read(map & MAP_INDEX));
+    }
+    return(sim_sfr[map]);
+}
+
+static inline void file_write(uint8_t f, uint8_t value)
+{
+    uint16_t map = memMap[(cpu.bsr << 7) | f];
+
+    dirty = true;
+    if(map & MAP_SFR)
+    {
+        sfr_write(map & MAP_INDEX, value);
+    }
+    else if(map & MAP_CORE)
+    {
+        core_write(map & MAP_INDEX, value);
+    }
+    else
+    {
+        sim_sfr[map] = value;
+    }
+}
+
+// True if file register f in the current bank is plain RAM.
+static inline bool file_is_ram(uint8_t f)
+{
+    return(!(memMap[(cpu.bsr << 7) | f] & (MAP_SFR | MAP_CORE)));
+}
+
+// Hardware return stack. With STVREN set in the configuration words, an
+// overflow or underflow resets the PIC.
+static void push(uint16_t addr)
+{
+    if(cpu.sp == PIC16_STACK)
+    {
+        pic16_stats.stackErrors++;
+        sim_halt(SIM_HALT_RESET);
+    }
+    stack[cpu.sp++] = addr;
+}
+
+static uint16_t pop(void)
+{
+    if(cpu.sp == 0)
+    {
+        pic16_stats.stackErrors++;
+        sim_halt(SIM_HALT_RESET);
+    }
+    return(stack[--cpu.sp]);
+}
+
+// Interrupt: save the context in the shadow registers and vector to 0x0004
+// (past the bootloader, at the code offset).
+static void interrupt(void)
+{
+    push(pc);
+    sim_sfr[SHAD_STATUS] = cpu.status;
+    sim_sfr[SHAD_WREG] = cpu.w;
+    sim_sfr[SHAD_BSR] = cpu.bsr;
+    sim_sfr[SHAD_PCLATH] = cpu.pclath;
+    sim_sfr[SHAD_FSR0L] = cpu.fsr[0] & 0xFF;
+    sim_sfr[SHAD_FSR0L + 1] = cpu.fsr[0] >> 8;
+    sim_sfr[SHAD_FSR0L + 2] = cpu.fsr[1] & 0xFF;
+    sim_sfr[SHAD_FSR0L + 3] = cpu.fsr[1] >> 8;
+    sim_sfr[SFR_INTCON] &= ~0x80;
+    irqReady = false;
+    dirty = true;
+    pc = pic16_offset + 4;
+    now += 2 * cpi;
+    pic16_stats.interrupts++;
+}
+
+static void retfie(void)
+{
+    pc = pop();
+    cpu.status = sim_sfr[SHAD_STATUS];
+    cpu.w = sim_sfr[SHAD_WREG];
+    cpu.bsr = sim_sfr[SHAD_BSR] & 0x1F;
+    cpu.pclath = sim_sfr[SHAD_PCLATH] & 0x7F;
+    cpu.fsr[0] = (uint16_t)(sim_sfr[SHAD_FSR0L] | (sim_sfr[SHAD_FSR0L + 1] << 8));
+    cpu.fsr[1] = (uint16_t)(sim_sfr[SHAD_FSR0L + 2] | (sim_sfr[SHAD_FSR0L + 3] << 8));
+    sim_sfr[SFR_INTCON] |= 0x80;
+    irqReady = sim_cpu_irq();
+}
+
+// Backward branch to pc. If this pass of the loop changed nothing (same
+// registers, no memory written, no timer read and no board event), every
+// further pass will do the same until the next board event, so skip the
+// whole passes that fit before it.
+static void loop_check(void)
+{
+    if(pc == loopPC && !dirty && memcmp(&cpu, &loopRegs, sizeof(cpu)) == 0)
+    {
+        uint64_t pass = now - loopTime;
+        uint64_t passes;
+
+        if(nextEvent == SIM_NEVER)
+        {
+            sim_halt(SIM_HALT_STUCK);
+        }
+        passes = now < nextEvent ? (nextEvent - now) / pass : 0;
+        now += passes * pass;
+        pic16_stats.skipped += passes * (pic16_stats.instructions - loopCount);
+    }
+    loopPC = pc;
+    loopRegs = cpu;
+    loopTime = now;
+    loopCount = pic16_stats.instructions;
+    dirty = false;
+}
+
+// Counted delay loop: DECFSZ or INCFSZ f,F didn't skip, and the branch
+// after it went back to it. Count f down (or up) in one step, stopping short
+// of the next board event and of the last pass (the one that skips).
+static void delay_loop(const insn_t *count)
+{
+    uint8_t value = file_read((uint8_t)count->k);
+    uint64_t passes = (count->op == OP_DECFSZ) ? value - 1u : 255u - value;
+    uint64_t pass = 3 * cpi;        // 1-cycle count, 2-cycle branch
+
+    if(now >= nextEvent)
+    {
+        return;
+    }
+    if((nextEvent - now) / pass < passes)
+    {
+        passes = (nextEvent - now) / pass;
+    }
+    if(passes == 0)
+    {
+        return;
+    }
+    value = (count->op == OP_DECFSZ) ? (uint8_t)(value - passes) : (uint8_t)(value + passes);
+    sim_sfr[memMap[(cpu.bsr << 7) | count->k]] = value;
+    dirty = true;
+    now += passes * pass;
+    pic16_stats.skipped += 2 * passes;
+}
+
+// Flags of an addition (carry in c) or subtraction (a + ~b + c).
+static uint8_t add_flags(uint8_t a, uint8_t b, uint8_t c)
+{
+    unsigned int sum = a + b + c;
+
+    cpu.status &= ~(ST_C | ST_DC | ST_Z);
+    cpu.status |= (sum > 0xFF) ? ST_C : 0;
+    cpu.status |= (((a & 0x0F) + (b & 0x0F) + c) > 0x0F) ? ST_DC : 0;
+    cpu.status |= ((uint8_t)sum == 0) ? ST_Z : 0;
+    return((uint8_t)sum);
+}
+
+static inline uint8_t set_z(uint8_t value)
+{
+    cpu.status = (cpu.status & ~ST_Z) | (value == 0 ? ST_Z : 0);
+    return(value);
+}
+
+static inline void set_c(bool carry)
+{
+    cpu.status = (cpu.status & ~ST_C) | (carry ? ST_C : 0);
+}
+
+// Execute from the reset vector until the run halts.
+static void run(void)
+{
+    for(;;)
+    {
+        const insn_t *in;
+        uint32_t cycles = 1;
+        bool backward = false;
+        uint8_t f;
+        uint8_t r;
+        uint8_t t;
+
+        if(now >= nextEvent)
+        {
+            board_sync();
+        }
+        if(irqReady)
+        {
+            interrupt();
+            continue;
+        }
+
+        in = &code[pc & (SIM_FLASH_WORDS - 1)];
+        pc = (pc + 1) & 0x7FFF;
+        f = (uint8_t)in->k;
+        pic16_stats.instructions++;
+
+// Store a byte operation result in W or the file register.
+#define STORE(value)    do { r = (value); if(in->d) file_write(f, r); else cpu.w = r; } while(0)
+
+        switch(in->op)
+        {
+        case OP_NOP:
+            break;
+        case OP_ADDWF:
+            r = file_read(f);
+            STORE(add_flags(r, cpu.w, 0));
+            break;
+        case OP_ADDWFC:
+            r = file_read(f);
+            STORE(add_flags(r, cpu.w, cpu.status & ST_C));
+            break;
+        case OP_SUBWF:
+            r = file_read(f);
+            STORE(add_flags(r, (uint8_t)~cpu.w, 1));
+            break;
+        case OP_SUBWFB:
+            r = file_read(f);
+            STORE(add_flags(r, (uint8_t)~cpu.w, cpu.status & ST_C));
+            break;
+        case OP_ANDWF:
+            STORE(set_z(file_read(f) & cpu.w));
+            break;
+        case OP_IORWF:
+            STORE(set_z(file_read(f) | cpu.w));
+            break;
+        case OP_XORWF:
+            STORE(set_z(file_read(f) ^ cpu.w));
+            break;
+        case OP_COMF:
+            STORE(set_z((uint8_t)~file_read(f)));
+            break;
+        case OP_DECF:
+            STORE(set_z((uint8_t)(file_read(f) - 1)));
+            break;
+        case OP_INCF:
+            STORE(set_z((uint8_t)(file_read(f) + 1)));
+            break;
+        case OP_MOVF:
+            STORE(set_z(file_read(f)));
+            break;
+        case OP_DECFSZ:
+        case OP_INCFSZ:
+            r = file_read(f);
+            STORE((uint8_t)(in->op == OP_DECFSZ ? r - 1 : r + 1));
+            if(r == 0)
+            {
+                pc = (pc + 1) & 0x7FFF;
+                cycles = 2;
+            }
+            break;
+        case OP_RLF:
+            r = file_read(f);
+            t = (uint8_t)((r << 1) | (cpu.status & ST_C));
+            set_c(r & 0x80);
+            STORE(t);
+            break;
+        case OP_RRF:
+            r = file_read(f);
+            t = (uint8_t)((r >> 1) | ((cpu.status & ST_C) << 7));
+            set_c(r & 0x01);
+            STORE(t);
+            break;
+        case OP_LSLF:
+            r = file_read(f);
+            set_c(r & 0x80);
+            STORE(set_z((uint8_t)(r << 1)));
+            break;
+        case OP_LSRF:
+            r = file_read(f);
+            set_c(r & 0x01);
+            STORE(set_z(r >> 1));
+            break;
+        case OP_ASRF:
+            r = file_read(f);
+            set_c(r & 0x01);
+            STORE(set_z((uint8_t)((r >> 1) | (r & 0x80))));
+            break;
+        case OP_SWAPF:
+            r = file_read(f);
+            STORE((uint8_t)((r << 4) | (r >> 4)));
+            break;
+        case OP_MOVWF:
+            file_write(f, cpu.w);
+            break;
+        case OP_CLRF:
+            file_write(f, 0);
+            set_z(0);
+            break;
+        case OP_CLRW:
+            cpu.w = set_z(0);
+            break;
+
+        case OP_BCF:
+            file_write(f, file_read(f) & ~in->d);
+            break;
+        case OP_BSF:
+            file_write(f, file_read(f) | in->d);
+            break;
+        case OP_BTFSC:
+        case OP_BTFSS:
+            r = file_read(f) & in->d;
+            if((r == 0) == (in->op == OP_BTFSC))
+            {
+                pc = (pc + 1) & 0x7FFF;
+                cycles = 2;
+            }
+            break;
+
+        case OP_ADDLW:
+            cpu.w = add_flags(cpu.w, (uint8_t)in->k, 0);
+            break;
+        case OP_SUBLW:
+            cpu.w = add_flags((uint8_t)in->k, (uint8_t)~cpu.w, 1);
+            break;
+        case OP_ANDLW:
+            cpu.w = set_z(cpu.w & (uint8_t)in->k);
+            break;
+        case OP_IORLW:
+            cpu.w = set_z(cpu.w | (uint8_t)in->k);
+            break;
+        case OP_XORLW:
+            cpu.w = set_z(cpu.w ^ (uint8_t)in->k);
+            break;
+        case OP_MOVLW:
+            cpu.w = (uint8_t)in->k;
+            break;
+        case OP_MOVLB:
+            cpu.bsr = (uint8_t)in->k;
+            break;
+        case OP_MOVLP:
+            cpu.pclath = (uint8_t)in->k;
+            break;
+
+        case OP_GOTO:
+            backward = ((cpu.pclath & 0x78) << 8 | in->k) < pc;
+            pc = (uint16_t)(((cpu.pclath & 0x78) << 8) | in->k);
+            cycles = 2;
+            break;
+        case OP_BRA:
+            backward = (int16_t)in->k < 0;
+            pc = (pc + in->k) & 0x7FFF;
+            cycles = 2;
+            break;
+        case OP_CALL:
+            push(pc);
+            pc = (uint16_t)(((cpu.pclath & 0x78) << 8) | in->k);
+            cycles = 2;
+            break;
+        case OP_CALLW:
+            push(pc);
+            pc = (uint16_t)((cpu.pclath << 8) | cpu.w);
+            cycles = 2;
+            break;
+        case OP_BRW:
+            pc = (pc + cpu.w) & 0x7FFF;
+            cycles = 2;
+            break;
+        case OP_RETLW:
+            cpu.w = (uint8_t)in->k;
+            /* fall through */
+        case OP_RETURN:
+            pc = pop();
+            cycles = 2;
+            break;
+        case OP_RETFIE:
+            retfie();
+            cycles = 2;
+            break;
+
+        case OP_ADDFSR:
+            cpu.fsr[in->d] += in->k;
+            break;
+        case OP_MOVIW:
+        case OP_MOVWI:
+            if(in->k == 0)          // ++FSRn
+                cpu.fsr[in->d]++;
+            else if(in->k == 1)     // --FSRn
+                cpu.fsr[in->d]--;
+            if(in->op == OP_MOVIW)
+                cpu.w = set_z(ind_read(cpu.fsr[in->d]));
+            else
+                ind_write(cpu.fsr[in->d], cpu.w);
+            if(in->k == 2)          // FSRn++
+                cpu.fsr[in->d]++;
+            else if(in->k == 3)     // FSRn--
+                cpu.fsr[in->d]--;
+            break;
+        case OP_MOVIWK:
+            cpu.w = set_z(ind_read((uint16_t)(cpu.fsr[in->d] + in->k)));
+            break;
+        case OP_MOVWIK:
+            ind_write((uint16_t)(cpu.fsr[in->d] + in->k), cpu.w);
+            break;
+
+        case OP_CLRWDT:
+            sim_clrwdt();
+            cpu.status |= ST_TO | ST_PD;
+            break;
+        case OP_SLEEP:
+            board_sync();
+            if(!sim_cpu_irq())          // (a pending interrupt makes it a NOP)
+            {
+                cpu.status = (cpu.status & ~ST_PD) | ST_TO;
+                sim_cpu_sleep();
+                now = sim_now;
+                if(!sim_cpu_irq())
+                {
+                    cpu.status &= ~ST_TO;   // Woken by the watchdog
+                }
+            }
+            board_sync();
+            dirty = true;
+            break;
+        case OP_RESET:
+            sim_halt(SIM_HALT_RESET);
+            break;
+        case OP_OPTION:
+            sfr_write(SFR_OPTION_REG, cpu.w);
+            break;
+        case OP_TRIS:
+            sfr_write(SFR_TRISA + (in->k - 5), cpu.w);
+            break;
+        }
+#undef STORE
+
+        now += cycles * cpi;
+        if(backward && pic16_skip)
+        {
+            const insn_t *count = &code[pc & (SIM_FLASH_WORDS - 1)];
+
+            if(count == in - 1 && count->d &&
+               (count->op == OP_DECFSZ || count->op == OP_INCFSZ) &&
+               file_is_ram((uint8_t)count->k))
+            {
+                delay_loop(count);
+            }
+            else
+            {
+                loop_check();
+            }
+        }
+    }
+}
+
+// Reset the CPU and run the image. Called through sim_run().
+int pic16_run(void)
+{
+    map_init();
+    decode_all();
+    memset(&cpu, 0, sizeof(cpu));
+    memset(&pic16_stats, 0, sizeof(pic16_stats));
+    cpu.status = ST_TO | ST_PD;
+    pc = pic16_offset;
+    now = sim_now;
+    nextEvent = 0;
+    cpi = clock_cpi();
+    irqReady = false;
+    dirty = true;
+    loopPC = 0xFFFF;
+    run();
+    return(0);
+}
+
+// Interrupt function for the dispatcher in sim.c (built with
+// -DSIM_ISR=pic16_isr). Never called: the CPU vectors its own interrupts, and
+// holds GIE off while the board stalls it for a flash write.
+void pic16_isr(void)
+{
+    sim_halt(SIM_HALT_ISR);
+}
+
+static int hex_byte(const char *s)
+{
+    int value = 0;
+    int i;
+
+    for(i = 0; i != 2; i++)
+    {
+        char c = s[i];
+
+        value <<= 4;
+        if(c >= '0' && c <= '9')
+            value |= c - '0';
+        else if(c >= 'A' && c <= 'F')
+            value |= c - 'A' + 10;
+        else if(c >= 'a' && c <= 'f')
+            value |= c - 'a' + 10;
+        else
+            return(-1);
+    }
+    return(value);
+}
+
+// Load an Intel HEX image (XC8 -ginhx32: byte addresses, little-endian
+// words, type 04 records for the upper address).
+int pic16_load_hex(const char *path)
+{
+    static bool loaded[SIM_FLASH_WORDS];
+    FILE *file = fopen(path, "r");
+    char line[600];
+    uint32_t upper = 0;
+    int words = 0;
+    int status = -1;
+
+    if(file == NULL)
+    {
+        return(-1);
+    }
+    sim_flash_blank();
+    memset(loaded, 0, sizeof(loaded));
+    while(fgets(line, sizeof(line), file) != NULL)
+    {
+        uint8_t data[256];
+        int count, type, sum, i;
+        uint32_t addr;
+
+        if(line[0] != ':')
+        {
+            continue;
+        }
+        count = hex_byte(line + 1);
+        if(count < 0 || strlen(line) < (size_t)(11 + 2 * count))
+        {
+            goto done;
+        }
+        sum = count;
+        for(i = 0; i != count + 4; i++)     // Address, type, data, checksum
+        {
+            int byte = hex_byte(line + 3 + 2 * i);
+
+            if(byte < 0)
+            {
+                goto done;
+            }
+            sum += byte;
+            if(i >= 3 && i < count + 3)
+            {
+                data[i - 3] = (uint8_t)byte;
+            }
+        }
+        if((sum & 0xFF) != 0)
+        {
+            goto done;
+        }
+        addr = (uint32_t)((hex_byte(line + 3) << 8) | hex_byte(line + 5));
+        type = hex_byte(line + 7);
+        if(type == 0x00)            // Data
+        {
+            for(i = 0; i != count; i++)
+            {
+                uint32_t byteAddr = upper + addr + (uint32_t)i;
+                uint32_t word = byteAddr / 2;
+
+                if(word >= SIM_FLASH_WORDS)
+                {
+                    continue;       // Configuration words and IDs
+                }
+                if(byteAddr & 1)
+                {
+                    sim_flash[word] = (uint16_t)((sim_flash[word] & 0x00FF) | ((data[i] & 0x3F) << 8));
+                }
+                else
+                {
+                    sim_flash[word] = (uint16_t)((sim_flash[word] & 0x3F00) | data[i]);
+                }
+                if(!loaded[word])
+                {
+                    loaded[word] = true;
+                    words++;
+                }
+            }
+        }
+        else if(type == 0x01)       // End of file
+        {
+            break;
+        }
+        else if(type == 0x02)       // Extended segment address
+        {
+            upper = (uint32_t)((data[0] << 8) | data[1]) << 4;
+        }
+        else if(type == 0x04)       // Extended linear address
+        {
+            upper = (uint32_t)((data[0] << 8) | data[1]) << 16;
+        }
+    }
+    pic16_offset = (!loaded[0] && loaded[0x800]) ? 0x800 : 0;
+    status = words;
+
+done:
+    fclose(file);
+    return(status);
+}
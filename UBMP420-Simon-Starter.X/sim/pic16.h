@@ -0,0 +1,75 @@
+/*==============================================================================
+ File: sim/pic16.h
+ Date: October 16, 2026
+
+ Enhanced mid-range PIC16 (PIC16F1459) instruction set emulator definitions
+
+ Runs the compiled firmware image - the .hex file built by the MPLAB X
+ project - on the simulated board in sim.c, instead of the host-compiled
+ firmware. Program memory is the simulator's flash (sim_flash[]), so self-
+ writes and HEF reads work on the same words, and data memory is the
+ simulator's register model (sim_sfr[]), so the SFRs the firmware touches
+ are the ones sim.c already models: the ports, latches and TRIS registers,
+ Timer0/1/2, IOC, the ADC, OSCCON/OSCSTAT, the watchdog and the program
+ memory controls.
+
+ Every instruction is counted in virtual time (1 or 2 instruction cycles,
+ each 1/12 us at 48 MHz or 1/4 us when running from the 16 MHz HFINTOSC).
+ The board is brought up to date only when the code touches an SFR or a
+ peripheral event falls due, so plain code runs at the speed of a switch
+ statement. A loop that waits for an interrupt (the same registers at the
+ same backward branch, with no memory changed and no timer read since) is
+ skipped ahead to the next peripheral event a whole number of passes at a
+ time, and the DECFSZ/INCFSZ counting loops XC8 builds __delay_ms() from are
+ counted down the same way. Both give exactly the same result as running
+ every pass.
+
+ The peripherals in sim.c always count at 48 MHz, so timer periods are only
+ right while the firmware runs from the PLL - the code itself runs at the
+ OSCCON clock.
+==============================================================================*/
+
+#ifndef PIC16_H
+#define PIC16_H
+
+#include    <stdint.h>
+#include    <stdbool.h>
+
+#define PIC16_STACK     16          // Hardware return stack levels
+#define PIC16_BLANK     0x3FFF      // Erased program word
+
+// Emulator statistics
+typedef struct
+{
+    uint64_t instructions;          // Instructions executed
+    uint64_t skipped;               // Instructions skipped in waiting loops
+    uint64_t interrupts;            // Interrupts taken
+    uint64_t syncs;                 // Board updates
+    uint32_t stackErrors;           // Stack overflows and underflows
+} pic16_stats_t;
+
+extern pic16_stats_t pic16_stats;
+extern uint16_t pic16_offset;       // Reset vector address (code offset)
+extern bool pic16_skip;             // Skip waiting and counted delay loops
+                                    // (default true; false runs every pass)
+
+/**
+ * Function: int pic16_load_hex(const char *path)
+ *
+ * Load an Intel HEX program image into the simulated flash, after blanking
+ * it. Configuration words (above program memory) are ignored. If the image
+ * has nothing at address 0 but code at 0x800 (a bootloader offset build),
+ * pic16_offset is set to 0x800. Returns the number of program words loaded,
+ * or -1 if the file can't be read or has a bad record.
+ */
+int pic16_load_hex(const char *);
+
+/**
+ * Function: int pic16_run(void)
+ *
+ * Reset the CPU and run the loaded image from pic16_offset until the run
+ * halts. Pass to sim_run() after sim_reset(), like a firmware main().
+ */
+int pic16_run(void);
+
+#endif
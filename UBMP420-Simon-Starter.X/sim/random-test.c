@@ -0,0 +1,131 @@
+/*==============================================================================
+ File: sim/random-test.c
+ Date: October 16, 2026
+
+ Random number generator test for UBMP420-random
+
+ Runs the firmware's generator as built for the host, where int is 32 bits
+ instead of XC8's 16, and checks that it is still the PIC's generator:
+
+   sequence  the first states from the 0xACE1 start match a 16-bit xorshift
+             with shifts 7, 9 and 8, worked out separately
+   period    every state fits in 16 bits, none is 0, and the generator comes
+             back to its start after exactly 65535 steps
+   button    every random_button() code is from 1 to 4, and over a whole
+             period each code comes up once for each state with its two top
+             bits (16384 times, or 16383 for 1, as the state is never 0)
+
+ Usage: random-test
+==============================================================================*/
+
+#include    <stdio.h>
+#include    <stdlib.h>
+
+#include    "sim.h"
+#include    "../UBMP420-random.h"
+
+#define PERIOD      65535           // States of a 16-bit xorshift (all but 0)
+
+extern uint16_t randomSeed;         // Firmware random generator state
+
+// States after the 0xACE1 start
+static const unsigned long sequence[] =
+{
+    0xD30F, 0xF1A5, 0x1734, 0xFF72, 0x1751, 0x318E, 0x03F5, 0xF009
+};
+
+static int failures = 0;
+
+static void fail(const char *test, const char *what, unsigned long detail)
+{
+    fprintf(stderr, "%s: %s (0x%lX)\n", test, what, detail);
+    failures++;
+}
+
+static void test_sequence(void)
+{
+    unsigned long value;
+    int i;
+
+    randomSeed = 0;                 // Replaced by 0xACE1
+    for(i = 0; i != sizeof(sequence) / sizeof(sequence[0]); i++)
+    {
+        value = random_next();
+        if(value != sequence[i])
+        {
+            fail("sequence", "wrong state", value);
+            return;
+        }
+    }
+    printf("sequence: %d states match the 16-bit xorshift 7/9/8\n", i);
+}
+
+static void test_period(void)
+{
+    unsigned long value;
+    long steps;
+
+    randomSeed = 0xACE1;
+    for(steps = 1; steps <= PERIOD; steps++)
+    {
+        value = random_next();
+        if(value == 0 || value > 0xFFFF)
+        {
+            fail("period", "state out of range", value);
+            return;
+        }
+        if(value == 0xACE1)
+        {
+            break;
+        }
+    }
+    printf("period:   back to the start after %ld steps\n", steps);
+    if(steps != PERIOD)
+    {
+        fail("period", "wrong period", (unsigned long)steps);
+    }
+}
+
+static void test_button(void)
+{
+    unsigned long counts[4] = {0, 0, 0, 0};
+    unsigned char code;
+    long i;
+
+    randomSeed = 0xACE1;
+    for(i = 0; i != PERIOD; i++)
+    {
+        code = random_button();
+        if(code < 1 || code > 4)
+        {
+            fail("button", "code out of range", code);
+            return;
+        }
+        counts[code - 1]++;
+    }
+    printf("button:   codes 1-4 drawn %lu, %lu, %lu and %lu times\n",
+           counts[0], counts[1], counts[2], counts[3]);
+    if(counts[0] != 16383 || counts[1] != 16384 || counts[2] != 16384 || counts[3] != 16384)
+    {
+        fail("button", "uneven codes", counts[0]);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    if(argc > 1)
+    {
+        fprintf(stderr, "usage: %s\n", argv[0]);
+        return(2);
+    }
+
+    test_sequence();
+    test_period();
+    test_button();
+    if(failures != 0)
+    {
+        fprintf(stderr, "%d random test failure(s)\n", failures);
+        return(1);
+    }
+    return(0);
+}
@@ -0,0 +1,753 @@
+/*==============================================================================
+ File: sim/sim.c
+ Date: October 16, 2026
+
+ UBMP4.2 (PIC16F1459) host simulator
+
+ Peripheral and virtual clock model for host builds of the UBMP4 firmware.
+ The firmware writes the SFRs in sim_sfr[] directly; every time the virtual
+ clock is about to move, sim_sync() looks at the registers to pick up what the
+ firmware changed (timer writes, ADC starts, output latches) and the timers
+ are then advanced in one step to the next event. Nothing is simulated
+ cycle-by-cycle, so idle stretches of virtual time cost almost nothing.
+==============================================================================*/
+
+#include    <setjmp.h>
+#include    <string.h>
+
+#include    "sim.h"
+
+// Firmware interrupt function, named by the build (e.g. -DSIM_ISR=wake)
+extern void SIM_ISR(void);
+
+volatile uint8_t sim_sfr[SIM_SFR_SIZE] __attribute__((aligned(2)));
+uint64_t sim_now;
+uint64_t sim_sleep_cycles;
+uint64_t sim_hfintosc_cycles;
+uint64_t sim_pll_lock = SIM_PLL_LOCK;
+uint64_t sim_osc_wake = SIM_OSC_WAKE;
+uint64_t sim_limit = SIM_NEVER;
+uint32_t sim_isr_cycles = 0;
+uint16_t sim_analog[32];
+uint16_t sim_flash[SIM_FLASH_WORDS];
+uint32_t sim_flash_erases[SIM_FLASH_ROWS];
+uint32_t sim_flash_endurance = 0;
+uint32_t sim_flash_fail = 0;
+sim_hooks_t sim_hooks;
+
+// Simulator state
+static jmp_buf simExit;             // Return point for a halted run
+static uint8_t pinIn[3];            // Externally driven pin levels, port A-C
+static uint64_t inputTime = SIM_NEVER;  // Next input() hook call
+static uint64_t adcDone = SIM_NEVER;    // End of the conversion in progress
+static uint64_t wdtWake = SIM_NEVER;    // Watchdog wake-up from sleep
+static bool sleeping = false;       // True while in SLEEP (FOSC stopped)
+static bool stalled = false;        // True while waking, waiting for the PLL
+static uint64_t pllReady = SIM_NEVER;   // PLL lock after a wake-up
+static uint64_t clockRem;           // Cycles towards the next timer count
+                                    // on the 16 MHz clock
+
+static uint64_t pre0, pre1, pre2;   // Timer prescaler counts (cycles)
+static uint8_t post2;               // Timer2 postscaler count
+static uint8_t shadowTMR0, shadowTMR2, shadowT2CON;
+static uint16_t shadowTMR1;         // Timer values left by the last update
+static uint8_t lastLATA, lastLATC;  // Outputs reported to the output() hook
+static uint16_t flashLatch[SIM_FLASH_ROW];  // Flash write latches
+static bool flashValid = false;     // sim_flash[] has been initialised
+
+static void timer_advance(uint64_t);
+static void timer_run(uint64_t);
+
+#define REG(addr)   (sim_sfr[(addr)])
+#define TMR1VAL     (*(volatile uint16_t *)&sim_sfr[SFR_TMR1L])
+
+// Erase the whole flash, as for a new chip.
+void sim_flash_blank(void)
+{
+    int i;
+
+    for(i = 0; i != SIM_FLASH_WORDS; i++)
+    {
+        sim_flash[i] = 0x3FFF;
+    }
+    memset(sim_flash_erases, 0, sizeof(sim_flash_erases));
+    flashValid = true;
+}
+
+// Power-on reset the simulated board. The flash keeps its contents.
+void sim_reset(void)
+{
+    int i;
+
+    if(!flashValid)
+    {
+        sim_flash_blank();
+    }
+    for(i = 0; i != SIM_FLASH_ROW; i++)
+    {
+        flashLatch[i] = 0x3FFF;
+    }
+    memset((void *)sim_sfr, 0, sizeof(sim_sfr));
+    sim_now = 0;
+    sim_sleep_cycles = 0;
+    sim_hfintosc_cycles = 0;
+    inputTime = SIM_NEVER;
+    adcDone = SIM_NEVER;
+    wdtWake = SIM_NEVER;
+    sleeping = false;
+    stalled = false;
+    pllReady = SIM_NEVER;
+    clockRem = 0;
+    pre0 = pre1 = pre2 = 0;
+    post2 = 0;
+
+    REG(SFR_STATUS) = 0x18;         // nTO, nPD (power-on)
+    REG(SFR_OPTION_REG) = 0xFF;
+    REG(SFR_TRISA) = 0xFF;
+    REG(SFR_TRISB) = 0xFF;
+    REG(SFR_TRISC) = 0xFF;
+    REG(SFR_ANSELA) = 0x10;
+    REG(SFR_ANSELB) = 0x30;
+    REG(SFR_ANSELC) = 0xCF;
+    REG(SFR_PR2) = 0xFF;
+    REG(SFR_WDTCON) = 0x16;         // WDT period 2 s, software enable off
+    REG(SFR_OSCCON) = 0x3C;
+    REG(SFR_OSCSTAT) = 0x50;        // HFINTOSC ready, PLL locked
+    REG(SFR_WPUA) = 0x3F;
+    REG(SFR_WPUB) = 0xF0;
+
+    pinIn[0] = 0xFF;                // SW1 released (pulled up)
+    pinIn[1] = 0xFF;                // SW2-SW5 released (pulled up)
+    pinIn[2] = 0x00;
+    shadowTMR0 = 0;
+    shadowTMR1 = 0;
+    shadowTMR2 = 0;
+    shadowT2CON = 0;
+    lastLATA = 0;
+    lastLATC = 0;
+}
+
+void sim_halt(int reason)
+{
+    longjmp(simExit, reason);
+}
+
+// Run the firmware until the run halts.
+int sim_run(int (*entry)(void))
+{
+    int reason = setjmp(simExit);
+
+    if(reason == SIM_HALT_NONE)
+    {
+        entry();
+        reason = SIM_HALT_STUCK;    // Firmware main() returned
+    }
+    return(reason);
+}
+
+// Drive input pins. Edges set the interrupt-on-change flags.
+void sim_set_pins(uint8_t port, uint8_t mask, uint8_t level)
+{
+    uint8_t old = pinIn[port];
+    uint8_t now = (old & ~mask) | (level & mask);
+    uint8_t rise = ~old & now;
+    uint8_t fall = old & ~now;
+
+    pinIn[port] = now;
+    if(port == 0)
+    {
+        REG(SFR_IOCAF) |= (rise & REG(SFR_IOCAP)) | (fall & REG(SFR_IOCAN));
+    }
+    else if(port == 1)
+    {
+        REG(SFR_IOCBF) |= (rise & REG(SFR_IOCBP)) | (fall & REG(SFR_IOCBN));
+    }
+}
+
+void sim_schedule_input(uint64_t when)
+{
+    if(when < inputTime)
+    {
+        inputTime = when;
+    }
+}
+
+// ADC conversion time: 12 TAD, with TAD set by ADCON1 ADCS<2:0>.
+static uint64_t adc_cycles(void)
+{
+    static const uint8_t tadFosc[8] = {2, 8, 32, 0, 4, 16, 64, 0};
+    uint8_t adcs = (REG(SFR_ADCON1) >> 4) & 0x07;
+
+    if(tadFosc[adcs] == 0)
+    {
+        return(12 * 2 * SIM_CYCLES_PER_US);    // FRC, about 2 us TAD
+    }
+    return(12 * tadFosc[adcs] / 4 + 1);
+}
+
+// Pick up register changes made by the firmware since the last sync.
+static void sim_sync(void)
+{
+    uint8_t port;
+
+    if(REG(SFR_TMR0) != shadowTMR0)     // TMR0 write clears the prescaler
+    {
+        pre0 = 0;
+        shadowTMR0 = REG(SFR_TMR0);
+    }
+    if(TMR1VAL != shadowTMR1)           // TMR1 write clears the prescaler
+    {
+        pre1 = 0;
+        shadowTMR1 = TMR1VAL;
+    }
+    if(REG(SFR_TMR2) != shadowTMR2 || REG(SFR_T2CON) != shadowT2CON)
+    {
+        pre2 = 0;                       // TMR2 or T2CON write clears both
+        post2 = 0;                      // prescaler and postscaler
+        shadowTMR2 = REG(SFR_TMR2);
+        shadowT2CON = REG(SFR_T2CON);
+    }
+
+    if((REG(SFR_ADCON0) & 0x03) == 0x03)    // ADON and GO set?
+    {
+        if(adcDone == SIM_NEVER)
+        {
+            adcDone = sim_now + adc_cycles();
+        }
+    }
+    else
+    {
+        adcDone = SIM_NEVER;
+    }
+
+    // Port reads return pin levels for inputs and latches for outputs.
+    for(port = 0; port != 3; port++)
+    {
+        uint8_t tris = REG(SFR_TRISA + port);
+        uint8_t pins = (tris & pinIn[port]) | (~tris & REG(SFR_LATA + port));
+        REG(SFR_PORTA + port) = pins & ~REG(SFR_ANSELA + port);
+    }
+
+    if(REG(SFR_IOCAF) != 0 || REG(SFR_IOCBF) != 0)
+    {
+        REG(SFR_INTCON) |= 0x01;        // IOCIF is the OR of all IOC flags
+    }
+    else
+    {
+        REG(SFR_INTCON) &= ~0x01;
+    }
+
+    if(REG(SFR_LATA) != lastLATA || REG(SFR_LATC) != lastLATC)
+    {
+        lastLATA = REG(SFR_LATA);
+        lastLATC = REG(SFR_LATC);
+        if(sim_hooks.output)
+        {
+            sim_hooks.output(sim_hooks.ctx, sim_now, lastLATA, lastLATC);
+        }
+    }
+}
+
+// Return true if an enabled interrupt flag is set (wakes SLEEP).
+static bool irq_pending(void)
+{
+    uint8_t intcon = REG(SFR_INTCON);
+
+    if((intcon & 0x20) && (intcon & 0x04))      // TMR0IE and TMR0IF
+        return(true);
+    if((intcon & 0x10) && (intcon & 0x02))      // INTE and INTF
+        return(true);
+    if((intcon & 0x08) && (intcon & 0x01))      // IOCIE and IOCIF
+        return(true);
+    if((intcon & 0x40) && ((REG(SFR_PIR1) & REG(SFR_PIE1)) ||
+                           (REG(SFR_PIR2) & REG(SFR_PIE2))))
+        return(true);
+    return(false);
+}
+
+// Call the interrupt function while GIE is set and an interrupt is pending.
+static void irq_dispatch(void)
+{
+    int calls = 0;
+
+    while((REG(SFR_INTCON) & 0x80) && irq_pending())
+    {
+        if(++calls > 1000)
+        {
+            sim_halt(SIM_HALT_ISR);
+        }
+        REG(SFR_INTCON) &= ~0x80;       // Hardware clears GIE on entry
+        if(sim_isr_cycles != 0)         // Latency and context save time
+        {
+            timer_run(sim_isr_cycles);
+            sim_now += sim_isr_cycles;
+        }
+        SIM_ISR();
+        REG(SFR_INTCON) |= 0x80;        // RETFIE sets GIE
+        sim_sync();
+    }
+}
+
+// True if Timer0 overflows start A-D conversions (ADCON2 TRIGSEL = 0011).
+static bool adc_tmr0_trigger(void)
+{
+    return((REG(SFR_ADCON2) & 0xF0) == 0x30 && (REG(SFR_ADCON0) & 0x01));
+}
+
+// Cycles until the next timer interrupt flag is set (or Timer0 overflow that
+// triggers the ADC), or SIM_NEVER.
+static uint64_t timer_next(void)
+{
+    uint64_t next = SIM_NEVER;
+    uint8_t option = REG(SFR_OPTION_REG);
+    uint8_t t1con = REG(SFR_T1CON);
+    uint8_t t2con = REG(SFR_T2CON);
+
+    if(((REG(SFR_INTCON) & 0x20) || adc_tmr0_trigger()) && !(option & 0x20))
+    {
+        uint64_t ps = (option & 0x08) ? 1 : (2u << (option & 0x07));
+        uint64_t t = (256 - REG(SFR_TMR0)) * ps - pre0;
+        next = t < next ? t : next;
+    }
+    if((t1con & 0x01) && (t1con & 0xC0) == 0x00)
+    {
+        uint64_t ps = 1u << ((t1con >> 4) & 0x03);
+        uint64_t t = (65536 - (uint64_t)TMR1VAL) * ps - pre1;
+        next = t < next ? t : next;
+    }
+    if(t2con & 0x04)
+    {
+        static const uint8_t ps2[4] = {1, 4, 16, 64};
+        uint64_t ps = ps2[t2con & 0x03];
+        uint8_t tmr2 = REG(SFR_TMR2);
+        uint8_t pr2 = REG(SFR_PR2);
+        uint64_t first = (tmr2 <= pr2) ? (uint64_t)(pr2 - tmr2 + 1) : (uint64_t)(256 - tmr2 + pr2 + 1);
+        uint64_t outps = ((t2con >> 3) & 0x0F) + 1;
+        uint64_t t = (first + (outps - post2 - 1) * ((uint64_t)pr2 + 1)) * ps - pre2;
+        next = t < next ? t : next;
+    }
+    return(next);
+}
+
+// Advance the FOSC-clocked timers by dt instruction cycles.
+static void timer_advance(uint64_t dt)
+{
+    uint8_t option = REG(SFR_OPTION_REG);
+    uint8_t t1con = REG(SFR_T1CON);
+    uint8_t t2con = REG(SFR_T2CON);
+
+    if(!(option & 0x20))                // Timer0 from FOSC/4
+    {
+        uint64_t ps = (option & 0x08) ? 1 : (2u << (option & 0x07));
+        uint64_t count = REG(SFR_TMR0) + (pre0 + dt) / ps;
+        pre0 = (pre0 + dt) % ps;
+        if(count >= 256)
+        {
+            REG(SFR_INTCON) |= 0x04;    // TMR0IF
+            if(adc_tmr0_trigger())      // Auto-conversion trigger: set GO
+            {
+                REG(SFR_ADCON0) |= 0x02;
+            }
+        }
+        REG(SFR_TMR0) = (uint8_t)count;
+        shadowTMR0 = REG(SFR_TMR0);
+    }
+    if((t1con & 0x01) && (t1con & 0xC0) == 0x00)    // Timer1 from FOSC/4
+    {
+        uint64_t ps = 1u << ((t1con >> 4) & 0x03);
+        uint64_t count = TMR1VAL + (pre1 + dt) / ps;
+        pre1 = (pre1 + dt) % ps;
+        if(count >= 65536)
+        {
+            REG(SFR_PIR1) |= 0x01;      // TMR1IF
+        }
+        TMR1VAL = (uint16_t)count;
+        shadowTMR1 = TMR1VAL;
+    }
+    if(t2con & 0x04)                    // Timer2 from FOSC/4
+    {
+        static const uint8_t ps2[4] = {1, 4, 16, 64};
+        uint64_t ps = ps2[t2con & 0x03];
+        uint64_t incs = (pre2 + dt) / ps;
+        uint8_t tmr2 = REG(SFR_TMR2);
+        uint8_t pr2 = REG(SFR_PR2);
+        uint64_t first = (tmr2 <= pr2) ? (uint64_t)(pr2 - tmr2 + 1) : (uint64_t)(256 - tmr2 + pr2 + 1);
+
+        pre2 = (pre2 + dt) % ps;
+        if(incs >= first)               // TMR2 matched PR2 at least once
+        {
+            uint64_t period = (uint64_t)pr2 + 1;
+            uint64_t matches = 1 + (incs - first) / period;
+            uint64_t outps = ((t2con >> 3) & 0x0F) + 1;
+
+            REG(SFR_TMR2) = (uint8_t)((incs - first) % period);
+            if(post2 + matches >= outps)
+            {
+                REG(SFR_PIR1) |= 0x02;  // TMR2IF
+            }
+            post2 = (uint8_t)((post2 + matches) % outps);
+        }
+        else
+        {
+            REG(SFR_TMR2) = (uint8_t)(tmr2 + incs);
+        }
+        shadowTMR2 = REG(SFR_TMR2);
+    }
+}
+
+// True while FOSC is the 16 MHz HFINTOSC: selected by SCS = 1x, or the PLL
+// clock selected but not locked yet.
+static bool clock_slow(void)
+{
+    return((REG(SFR_OSCCON) & 0x02) || !(REG(SFR_OSCSTAT) & 0x40));
+}
+
+// Run the FOSC-clocked timers for dt cycles of the 48 MHz virtual clock
+// (a third as many counts on the 16 MHz clock).
+static void timer_run(uint64_t dt)
+{
+    if(!clock_slow())
+    {
+        timer_advance(dt);
+        return;
+    }
+    clockRem += dt;
+    timer_advance(clockRem / 3);
+    clockRem %= 3;
+}
+
+// Virtual clock cycles until the timers have made counts counts.
+static uint64_t timer_cycles(uint64_t counts)
+{
+    if(!clock_slow())
+    {
+        return(counts);
+    }
+    return(counts * 3 - clockRem);
+}
+
+// Move the clock to time t and handle the events that are due then.
+static void step_to(uint64_t t)
+{
+    if(t > sim_limit)
+    {
+        t = sim_limit;
+    }
+    if(sleeping)
+    {
+        sim_sleep_cycles += t - sim_now;
+    }
+    else
+    {
+        if(clock_slow())
+        {
+            sim_hfintosc_cycles += t - sim_now;
+        }
+        if(!stalled)                    // FOSC isn't running while waking
+        {                               // on the PLL clock
+            timer_run(t - sim_now);
+        }
+    }
+    sim_now = t;
+
+    if(pllReady <= sim_now)             // PLL locked
+    {
+        REG(SFR_OSCSTAT) |= 0x40;       // PLLRDY
+        pllReady = SIM_NEVER;
+    }
+
+    if(adcDone <= sim_now)              // Conversion finished
+    {
+        uint8_t chs = (REG(SFR_ADCON0) >> 2) & 0x1F;
+        uint16_t value = sim_analog[chs] & 0x3FF;
+
+        if(REG(SFR_ADCON1) & 0x80)      // ADFM: right justified
+        {
+            REG(SFR_ADRESH) = value >> 8;
+            REG(SFR_ADRESL) = value & 0xFF;
+        }
+        else
+        {
+            REG(SFR_ADRESH) = value >> 2;
+            REG(SFR_ADRESL) = (value & 0x03) << 6;
+        }
+        REG(SFR_ADCON0) &= ~0x02;       // Clear GO/nDONE
+        REG(SFR_PIR1) |= 0x40;          // ADIF
+        adcDone = SIM_NEVER;
+    }
+    if(inputTime <= sim_now)
+    {
+        inputTime = SIM_NEVER;
+        if(sim_hooks.input)
+        {
+            sim_schedule_input(sim_hooks.input(sim_hooks.ctx, sim_now));
+        }
+    }
+    if(sim_now >= sim_limit)
+    {
+        sim_halt(SIM_HALT_LIMIT);
+    }
+}
+
+// Earliest pending event while awake, not later than target.
+static uint64_t next_event(uint64_t target)
+{
+    uint64_t t = timer_next();
+
+    t = (t == SIM_NEVER) ? SIM_NEVER : sim_now + timer_cycles(t);
+    if(adcDone < t)
+        t = adcDone;
+    if(pllReady < t)
+        t = pllReady;
+    if(inputTime < t)
+        t = inputTime;
+    if(sim_limit < t)
+        t = sim_limit;
+    if(target < t)
+        t = target;
+    return(t);
+}
+
+// Run the board until virtual time target, dispatching interrupts on the way.
+static void run_until(uint64_t target)
+{
+    for(;;)
+    {
+        sim_sync();
+        irq_dispatch();
+        if(sim_now >= target)
+        {
+            return;
+        }
+        step_to(next_event(target));
+    }
+}
+
+void sim_delay(uint64_t cycles)
+{
+    run_until(sim_now + cycles);
+}
+
+// Busy-wait loop body: jump to the next event so the firmware can re-check.
+void sim_wait_event(void)
+{
+    uint64_t next;
+
+    sim_sync();
+    irq_dispatch();
+    next = next_event(SIM_NEVER);
+    if(next == SIM_NEVER)
+    {
+        sim_halt(SIM_HALT_STUCK);
+    }
+    if(next <= sim_now)
+    {
+        step_to(sim_now);           // Input asked for now: call the hook
+    }
+    else
+    {
+        run_until(next);
+    }
+}
+
+// ei(): an interrupt whose flag is already set is taken right away, as on
+// the PIC (flags raised since the clock last moved are seen at the next event).
+void sim_ei(void)
+{
+    REG(SFR_INTCON) |= 0x80;
+    irq_dispatch();
+}
+
+void sim_clrwdt(void)
+{
+    wdtWake = SIM_NEVER;
+    REG(SFR_STATUS) |= 0x18;        // nTO, nPD
+}
+
+// Erase or write a flash row, stalling the firmware while the cells are
+// programmed. If the power is cut during the operation, only the high bits
+// of each word change (a torn erase or write) and the run halts.
+static void flash_program(uint16_t addr, bool erase)
+{
+    uint16_t row = addr & ~(SIM_FLASH_ROW - 1);
+    uint16_t torn = 0x0000;
+    int i;
+
+    if(sim_flash_fail != 0 && --sim_flash_fail == 0)
+    {
+        torn = 0x000F;              // Low bits are left as they were
+    }
+    for(i = 0; i != SIM_FLASH_ROW; i++)
+    {
+        if(erase)
+        {
+            sim_flash[row + i] |= 0x3FFF & ~torn;
+            if(sim_flash_endurance != 0 &&
+               sim_flash_erases[row / SIM_FLASH_ROW] >= sim_flash_endurance)
+            {
+                sim_flash[row + i] &= ~0x0001;  // Worn out: bit 0 sticks at 0
+            }
+        }
+        else
+        {
+            sim_flash[row + i] &= flashLatch[i] | torn; // Cells only go 1 to 0
+        }
+        flashLatch[i] = 0x3FFF;
+    }
+    if(erase)
+    {
+        sim_flash_erases[row / SIM_FLASH_ROW]++;
+    }
+    if(torn)
+    {
+        sim_halt(SIM_HALT_POWER);
+    }
+    run_until(sim_now + SIM_FLASH_MS * SIM_CYCLES_PER_MS);
+}
+
+// NOP after setting RD or WR: carry out the program memory operation. A
+// write needs WREN and the 0x55, 0xAA unlock sequence (modelled by checking
+// that 0xAA was the last value written to PMCON2).
+void sim_nop(void)
+{
+    uint8_t pmcon1 = REG(SFR_PMCON1);
+    uint16_t addr = (uint16_t)(((REG(SFR_PMADRH) & 0x7F) << 8) | REG(SFR_PMADRL));
+
+    if(pmcon1 & 0x40)               // CFGS: configuration space isn't modelled
+    {
+        REG(SFR_PMCON1) &= ~0x03;
+        return;
+    }
+    if(pmcon1 & 0x01)               // RD
+    {
+        REG(SFR_PMDATL) = sim_flash[addr] & 0xFF;
+        REG(SFR_PMDATH) = sim_flash[addr] >> 8;
+        REG(SFR_PMCON1) &= ~0x01;
+    }
+    else if(pmcon1 & 0x02)          // WR
+    {
+        REG(SFR_PMCON1) &= ~0x02;
+        if(!(pmcon1 & 0x04) || REG(SFR_PMCON2) != 0xAA)
+        {
+            REG(SFR_PMCON1) |= 0x08;    // WRERR: not enabled or unlocked
+            return;
+        }
+        REG(SFR_PMCON2) = 0;
+        if(pmcon1 & 0x10)           // FREE: erase the row
+        {
+            flash_program(addr, true);
+        }
+        else
+        {
+            flashLatch[addr & (SIM_FLASH_ROW - 1)] =
+                (uint16_t)(((REG(SFR_PMDATH) << 8) | REG(SFR_PMDATL)) & 0x3FFF);
+            if(!(pmcon1 & 0x20))    // LWLO clear: write the latches to the row
+            {
+                flash_program(addr, false);
+            }
+        }
+    }
+}
+
+// Stop FOSC and wait for an enabled interrupt or the watchdog. HFINTOSC and
+// the PLL stop too: if the PLL clock is selected (SCS = 00), the PIC only
+// runs again once the PLL has locked, but with HFINTOSC selected it runs as
+// soon as HFINTOSC has started and the PLL locks in the background. SLEEP
+// clears nPD, and a watchdog wake-up clears nTO. With an interrupt already
+// pending, SLEEP is a NOP and leaves both bits alone.
+static void sleep_wait(void)
+{
+    uint64_t run;                       // Time the PIC runs again
+
+    sim_sync();
+    if(!irq_pending())
+    {
+        sleeping = true;
+        REG(SFR_STATUS) = (REG(SFR_STATUS) & ~0x08) | 0x10; // nPD = 0, nTO
+        REG(SFR_OSCSTAT) &= ~0x40;      // PLLRDY
+        if(sim_hooks.sleep)
+        {
+            sim_hooks.sleep(sim_hooks.ctx, sim_now);
+        }
+        if((REG(SFR_ADCON1) & 0x30) != 0x30)   // ADC clocked from FOSC?
+        {
+            REG(SFR_ADCON0) &= ~0x02;   // Conversion is aborted in sleep
+            adcDone = SIM_NEVER;
+        }
+        wdtWake = SIM_NEVER;
+        if(REG(SFR_WDTCON) & 0x01)      // SWDTEN: WDT period from LFINTOSC
+        {
+            uint64_t lfCounts = 32ull << ((REG(SFR_WDTCON) >> 1) & 0x1F);
+            wdtWake = sim_now + lfCounts * (SIM_FOSC / 4) / 31000;
+        }
+        for(;;)
+        {
+            uint64_t t = inputTime < wdtWake ? inputTime : wdtWake;
+
+            if(t == SIM_NEVER)
+            {
+                sleeping = false;
+                sim_halt(SIM_HALT_ASLEEP);
+            }
+            step_to(t);
+            sim_sync();
+            if(irq_pending())
+            {
+                break;
+            }
+            if(wdtWake <= sim_now)
+            {
+                REG(SFR_STATUS) &= ~0x10;   // nTO: woken by the watchdog
+                break;
+            }
+        }
+        wdtWake = SIM_NEVER;
+        sleeping = false;
+        pllReady = sim_now + sim_pll_lock;
+        run = sim_now + sim_osc_wake;   // Wait for HFINTOSC to start, and
+        if(!(REG(SFR_OSCCON) & 0x02))   // on the PLL clock for it to lock
+        {
+            run = pllReady;
+        }
+        stalled = true;
+        while(sim_now < run)
+        {
+            step_to(inputTime < run ? inputTime : run);
+            sim_sync();
+        }
+        stalled = false;
+    }
+}
+
+// SLEEP: wait to wake up, then run the interrupt function if GIE is set.
+void sim_sleep(void)
+{
+    sleep_wait();
+    irq_dispatch();
+}
+
+// Instruction-level CPU models: bring the board up to time now (never
+// earlier than sim_now) without calling the firmware interrupt function, and
+// return the time of the next peripheral event.
+uint64_t sim_cpu_sync(uint64_t now)
+{
+    for(;;)
+    {
+        sim_sync();
+        if(sim_now >= now)
+        {
+            return(next_event(SIM_NEVER));
+        }
+        step_to(next_event(now));
+    }
+}
+
+bool sim_cpu_irq(void)
+{
+    return(irq_pending());
+}
+
+void sim_cpu_sleep(void)
+{
+    sleep_wait();
+}
@@ -0,0 +1,217 @@
+/*==============================================================================
+ File: sim/sim.h
+ Date: October 16, 2026
+
+ UBMP4.2 (PIC16F1459) host simulator definitions
+
+ The simulator models one UBMP4.2 board: the SFRs in sim_sfr[], a virtual
+ clock counted in instruction cycles (FOSC/4, 12 MHz at 48 MHz), Timer0/1/2,
+ interrupt-on-change, the ADC, the watchdog in sleep, HFINTOSC starting up
+ and the PLL locking after a wake-up (the timers count at a third of the
+ rate while FOSC is the 16 MHz HFINTOSC), and the interrupt controller.
+ Firmware code runs in zero virtual time - only __delay_us(), __delay_ms(),
+ WAIT_EVENT() and SLEEP() advance the clock, and peripherals are updated and
+ interrupts dispatched whenever the clock moves.
+
+ Test programs connect to the board through sim_hooks: input() is called at
+ the time it last asked for and may change the button pins, output() is
+ called on every change of the LATA/LATC outputs, and sleep() is called when
+ the firmware executes SLEEP. When nothing can ever wake the board again,
+ the run ends and sim_run() returns.
+
+ Program flash is modelled word by word in sim_flash[] and keeps its
+ contents across sim_reset(), like the real chip. Self-writes through the
+ PMCON1/PMCON2 registers take effect on the NOP() after setting RD or WR,
+ and a row erase or write stalls the firmware for 2 ms. Each row counts its
+ erases, and a test can make a row wear out after sim_flash_endurance
+ erases or cut the power part way through a flash operation.
+==============================================================================*/
+
+#ifndef SIM_H
+#define SIM_H
+
+#include    <stdint.h>
+#include    <stdbool.h>
+
+// PIC16F1459 linear data memory addresses of the modelled SFRs
+#define SIM_SFR_SIZE    0x1000
+#define SFR_STATUS      0x003
+#define SFR_INTCON      0x00B
+#define SFR_PORTA       0x00C
+#define SFR_PORTB       0x00D
+#define SFR_PORTC       0x00E
+#define SFR_PIR1        0x011
+#define SFR_PIR2        0x012
+#define SFR_TMR0        0x015
+#define SFR_TMR1L       0x016
+#define SFR_TMR1H       0x017
+#define SFR_T1CON       0x018
+#define SFR_T1GCON      0x019
+#define SFR_TMR2        0x01A
+#define SFR_PR2         0x01B
+#define SFR_T2CON       0x01C
+#define SFR_TRISA       0x08C
+#define SFR_TRISB       0x08D
+#define SFR_TRISC       0x08E
+#define SFR_PIE1        0x091
+#define SFR_PIE2        0x092
+#define SFR_OPTION_REG  0x095
+#define SFR_PCON        0x096
+#define SFR_WDTCON      0x097
+#define SFR_OSCTUNE     0x098
+#define SFR_OSCCON      0x099
+#define SFR_OSCSTAT     0x09A
+#define SFR_ADRESL      0x09B
+#define SFR_ADRESH      0x09C
+#define SFR_ADCON0      0x09D
+#define SFR_ADCON1      0x09E
+#define SFR_ADCON2      0x09F
+#define SFR_LATA        0x10C
+#define SFR_LATB        0x10D
+#define SFR_LATC        0x10E
+#define SFR_FVRCON      0x117
+#define SFR_ANSELA      0x18C
+#define SFR_ANSELB      0x18D
+#define SFR_ANSELC      0x18E
+#define SFR_PMADRL      0x191
+#define SFR_PMADRH      0x192
+#define SFR_PMDATL      0x193
+#define SFR_PMDATH      0x194
+#define SFR_PMCON1      0x195
+#define SFR_PMCON2      0x196
+#define SFR_WPUA        0x20C
+#define SFR_WPUB        0x20D
+#define SFR_IOCAP       0x391
+#define SFR_IOCAN       0x392
+#define SFR_IOCAF       0x393
+#define SFR_IOCBP       0x394
+#define SFR_IOCBN       0x395
+#define SFR_IOCBF       0x396
+#define SFR_ACTCON      0x39B
+
+// Virtual clock definitions
+#define SIM_FOSC        48000000UL              // Oscillator frequency
+#define SIM_CYCLES_PER_US (SIM_FOSC / 4000000UL) // Instruction cycles per us
+#define SIM_CYCLES_PER_MS (SIM_FOSC / 4000UL)    // Instruction cycles per ms
+#define SIM_NEVER       UINT64_MAX              // No event scheduled
+#define SIM_PLL_LOCK    (2 * SIM_CYCLES_PER_MS) // Default PLL lock time
+#define SIM_OSC_WAKE    (5 * SIM_CYCLES_PER_US) // Default HFINTOSC start-up
+
+// Reasons for the end of a simulation run
+#define SIM_HALT_NONE   0               // Still running
+#define SIM_HALT_ASLEEP 1               // Asleep with no wake-up source left
+#define SIM_HALT_RESET  2               // Firmware executed RESET()
+#define SIM_HALT_STUCK  3               // Firmware waiting with no event left
+#define SIM_HALT_LIMIT  4               // Virtual time limit reached
+#define SIM_HALT_ISR    5               // Interrupt flag never cleared by ISR
+#define SIM_HALT_POWER  6               // Power cut during a flash operation
+
+// Program flash definitions
+#define SIM_FLASH_WORDS 0x2000          // 8K words of 14 bits
+#define SIM_FLASH_ROW   32              // Words per erase and write row
+#define SIM_FLASH_ROWS  (SIM_FLASH_WORDS / SIM_FLASH_ROW)
+#define SIM_FLASH_MS    2               // Row erase or write time (ms)
+
+// Test program connections to the simulated board
+typedef struct
+{
+    uint64_t (*input)(void *ctx, uint64_t now); // Update inputs, return next call time
+    void (*output)(void *ctx, uint64_t now, uint8_t lata, uint8_t latc);
+    void (*sleep)(void *ctx, uint64_t now);     // Firmware entered SLEEP
+    void *ctx;                                  // Passed to each hook
+} sim_hooks_t;
+
+// Simulator state visible to test programs
+extern volatile uint8_t sim_sfr[SIM_SFR_SIZE];
+extern uint64_t sim_now;                // Virtual time (instruction cycles)
+extern uint64_t sim_sleep_cycles;       // Total cycles spent in SLEEP
+extern uint64_t sim_hfintosc_cycles;    // Total cycles awake on HFINTOSC, or
+                                        // waking until the PLL locks
+extern uint64_t sim_pll_lock;           // PLL lock time after a wake-up (cycles)
+extern uint64_t sim_osc_wake;           // HFINTOSC start-up after a wake-up
+extern uint64_t sim_limit;              // Halt the run at this virtual time
+extern uint32_t sim_isr_cycles;         // Cycles charged on each interrupt entry
+extern uint16_t sim_analog[32];         // 10-bit ADC input for each CHS channel
+extern uint16_t sim_flash[SIM_FLASH_WORDS]; // Program flash contents
+extern uint32_t sim_flash_erases[SIM_FLASH_ROWS];   // Erases of each row
+extern uint32_t sim_flash_endurance;    // Erases before a row wears out (0 = never)
+extern uint32_t sim_flash_fail;         // Cut the power during this flash
+                                        // operation from now (1 = next, 0 = never)
+extern sim_hooks_t sim_hooks;
+
+/**
+ * Function: void sim_reset(void)
+ *
+ * Power-on reset the simulated board: clear the clock and load the reset
+ * values of the modelled SFRs. All buttons are released.
+ */
+void sim_reset(void);
+
+/**
+ * Function: void sim_flash_blank(void)
+ *
+ * Erase all of the program flash (to 0x3FFF) and clear the erase counts, as
+ * for a new chip. Called by the first sim_reset().
+ */
+void sim_flash_blank(void);
+
+/**
+ * Function: int sim_run(int (*entry)(void))
+ *
+ * Run the firmware entry function (its renamed main()) until the run halts.
+ * Returns one of the SIM_HALT_ reasons.
+ */
+int sim_run(int (*)(void));
+
+/**
+ * Function: void sim_set_pins(uint8_t port, uint8_t mask, uint8_t level)
+ *
+ * Drive the masked input pins of port 0 (A), 1 (B) or 2 (C) to level. Pins
+ * with pull-ups float high when not driven low. Call from the input() hook.
+ */
+void sim_set_pins(uint8_t, uint8_t, uint8_t);
+
+/**
+ * Function: void sim_schedule_input(uint64_t when)
+ *
+ * Ask for the input() hook to be called at virtual time when (or earlier).
+ * Use from the output() and sleep() hooks to react to the firmware.
+ */
+void sim_schedule_input(uint64_t);
+
+/**
+ * Function: uint64_t sim_cpu_sync(uint64_t now)
+ *
+ * For instruction-level CPU models (pic16.c), which run the firmware's
+ * compiled code instead of calling it: move the board to virtual time now,
+ * picking up the SFR writes made since the last call, and return the time
+ * of the next peripheral event (SIM_NEVER if none). The interrupt function
+ * is never called - the CPU model checks sim_cpu_irq() and vectors itself.
+ */
+uint64_t sim_cpu_sync(uint64_t);
+
+/**
+ * Function: bool sim_cpu_irq(void)
+ *
+ * Return true if an enabled interrupt flag is set (GIE is not checked).
+ */
+bool sim_cpu_irq(void);
+
+/**
+ * Function: void sim_cpu_sleep(void)
+ *
+ * SLEEP for CPU models: return once an enabled interrupt or the watchdog
+ * wakes the board (halts the run if nothing can).
+ */
+void sim_cpu_sleep(void);
+
+// Functions called by the firmware through the macros in sim/xc.h
+void sim_delay(uint64_t);
+void sim_wait_event(void);
+void sim_ei(void);
+void sim_sleep(void);
+void sim_clrwdt(void);
+void sim_nop(void);
+void sim_halt(int);
+
+#endif
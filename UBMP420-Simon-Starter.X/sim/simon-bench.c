@@ -0,0 +1,360 @@
+/*==============================================================================
+ File: sim/simon-bench.c
+ Date: October 16, 2026
+
+ Sound and delay path timing benchmark for UBMP4-Simon-Game
+
+ Calls the firmware's note (every note in the note table), sound and game
+ status functions on the simulated board and reports how long each one
+ takes in instruction cycles, and the frequency actually produced on BEEPER
+ (measured from its edges) against the equal-tempered pitch of each note.
+ The jitter column is the spread between the shortest and longest
+ half-period of the tone, caused by other interrupts (system ticks, ADC
+ samples and LED PWM steps) delaying the tone interrupt. It also stops a
+ tone while a Timer1 overflow is pending, and fails if the beeper sounds
+ again afterwards.
+
+ Timing comes from the simulator's cycle model: timers, delays and waits are
+ exact, firmware code between them takes no time, and each interrupt entry is
+ charged the -l latency (default 20 cycles, an estimate of the PIC16F1459
+ interrupt latency plus XC8 context save). Because the tone ISR reloads
+ Timer1 after the latency, the latency shows up in the measured pitch the
+ same way it does on the PIC.
+
+ Usage: simon-bench [-l cycles] [-c cents] [-d level]
+   -l cycles  interrupt entry latency charged by the simulator (default 20)
+   -d level   play the tones with all LEDs on and dimmed to this PWM
+              brightness (1-15), to show the PWM engine's effect on tones
+   -c cents   fail (exit status 1) if a note is further off pitch than this,
+              or a tone's length is more than 1% off the requested duration
+==============================================================================*/
+
+#include    <math.h>
+#include    <stdio.h>
+#include    <stdlib.h>
+
+#include    "sim.h"
+#include    "../UBMP420-tick.h"
+#include    "../UBMP420-melody.h"
+
+// Firmware functions and variables under test
+extern void OSC_config(void);
+extern void UBMP4_config(void);
+extern void tone_config(void);
+extern void tick_config(void);
+extern void pwm_config(void);
+extern void pwm_set(unsigned char, unsigned char);
+extern void pwm_brightness(unsigned char);
+extern _Bool tone_busy(void);
+extern void tone_start(uint16_t, uint16_t);
+extern void tone_stop(void);
+extern void play_note(unsigned char, uint16_t);
+extern void sound(unsigned char);
+extern const melody_event_t startSong[], winSong[];
+extern void simon_task(void);
+extern void pattern_new(void);
+extern void pattern_add(void);
+extern unsigned char mode, state;
+extern uint16_t maxStep;
+extern uint16_t stateTimer;
+
+#define GAME_SIMON      1           // mode: simon game
+#define STATE_TURN_WAIT 0           // state: waiting to add the next step
+#define STATE_GET_GUESS 3           // state: waiting for the player
+#define STATE_LOSE_WAIT 6           // state: pause before the lose song
+
+// Note table range (MIDI note numbers, NOTE_A3 to NOTE_A6 in UBMP420-tone.h)
+#define NOTE_FIRST      57
+#define NOTE_LAST       93
+#define NOTE_MS         250         // Duration each note is played for
+
+static const char *noteNames[12] =
+{
+    "C", "C#", "D", "D#", "E", "F", "F#", "G", "G#", "A", "A#", "B"
+};
+
+// sound() cases and the notes they play
+static const struct
+{
+    unsigned char num;
+    double nominal;
+    unsigned int duration;
+} sounds[] =
+{
+    {1, 659.255, 287},
+    {2, 1108.731, 256},
+    {3, 1318.510, 287},
+    {4, 880.000, 256},
+};
+
+// BEEPER edge capture
+static unsigned long edges;
+static uint64_t firstEdge, lastEdge;
+static uint64_t minHalf, maxHalf;   // Shortest and longest half-period
+static uint8_t lastBeeper;
+
+static double maxCents = 0.0;       // -c limit (0 = report only)
+static int dimLevel = 0;            // -d LED brightness (0 = LEDs off)
+static int failures = 0;
+
+static void bench_output(void *ctx, uint64_t now, uint8_t lata, uint8_t latc)
+{
+    uint8_t beeper = lata & 0x10;
+
+    (void)ctx;
+    (void)latc;
+    if(beeper != lastBeeper)
+    {
+        if(edges == 0)
+        {
+            firstEdge = now;
+        }
+        else
+        {
+            if(now - lastEdge < minHalf)
+                minHalf = now - lastEdge;
+            if(now - lastEdge > maxHalf)
+                maxHalf = now - lastEdge;
+        }
+        lastEdge = now;
+        edges++;
+        lastBeeper = beeper;
+    }
+}
+
+static void capture_start(void)
+{
+    edges = 0;
+    firstEdge = lastEdge = sim_now;
+    minHalf = UINT64_MAX;
+    maxHalf = 0;
+}
+
+static double ms(uint64_t cycles)
+{
+    return((double)cycles / SIM_CYCLES_PER_MS);
+}
+
+// Report measured pitch and length of the tone just captured.
+static void report_tone(const char *name, double nominal, unsigned int duration, uint64_t cycles)
+{
+    double freq = 0.0;
+    double cents = 0.0;
+    double jitter = 0.0;
+    double length = ms(cycles);
+    int fail = 0;
+
+    if(edges > 2)
+    {
+        freq = (edges - 1) / 2.0 / ((double)(lastEdge - firstEdge) / (SIM_FOSC / 4));
+        cents = 1200.0 * log2(freq / nominal);
+        jitter = (double)(maxHalf - minHalf) / SIM_CYCLES_PER_US;
+    }
+    if(maxCents > 0.0 && (fabs(cents) > maxCents || edges <= 2 ||
+                          fabs(length - duration) > duration * 0.01))
+    {
+        fail = 1;
+        failures++;
+    }
+    printf("%-12s %10.3f %11.3f %+8.2f %9.2f %11llu %8.1f %6u %s\n", name,
+           nominal, freq, cents, jitter, (unsigned long long)cycles, length,
+           duration, fail ? "FAIL" : "");
+}
+
+// Time a firmware function call in instruction cycles.
+static uint64_t time_call(void (*fn)(void))
+{
+    uint64_t start = sim_now;
+
+    fn();
+    return(sim_now - start);
+}
+
+// Play a song from the scheduler, as the game does.
+static void play_song(const melody_event_t *song)
+{
+    task_t task = {melody_task, 1, 0};
+
+    melody_play(song);
+    while(melody_busy())
+    {
+        tick_run(&task, 1);
+    }
+}
+
+static void start_song(void)
+{
+    play_song(startSong);
+}
+
+static void win_song(void)
+{
+    play_song(winSong);
+}
+
+// Play the lose song and a score of 39 through the game state machine.
+static void lose_39(void)
+{
+    task_t tasks[] = {{melody_task, 1, 0}, {simon_task, 1, 0}};
+
+    maxStep = 40;                   // The score shown is maxStep - 1
+    mode = GAME_SIMON;
+    state = STATE_LOSE_WAIT;
+    stateTimer = 0;
+    while(mode == GAME_SIMON)
+    {
+        tick_run(tasks, 2);
+    }
+}
+
+static void power_up_beep(void)
+{
+    play_note(88, 19);              // NOTE_E6
+}
+
+// Play a whole 42-step pattern through the game state machine.
+static void replay_42(void)
+{
+    unsigned int i;
+
+    pattern_new();
+    for(i = 0; i != 41; i++)
+    {
+        pattern_add();
+    }
+    mode = GAME_SIMON;              // turnWait adds the 42nd step
+    state = STATE_TURN_WAIT;
+    stateTimer = 0;
+    while(state != STATE_GET_GUESS)
+    {
+        simon_task();
+        sim_delay(SIM_CYCLES_PER_MS);
+    }
+}
+
+static void report_call(const char *name, uint64_t cycles)
+{
+    printf("%-16s %14llu %12.1f\n", name, (unsigned long long)cycles, ms(cycles));
+}
+
+static int bench_main(void)
+{
+    unsigned int i;
+
+    OSC_config();
+    UBMP4_config();
+    tone_config();
+    tick_config();                  // simon_task() times its states with ticks
+    pwm_config();
+    sim_sfr[SFR_INTCON] |= 0x80;    // ei()
+
+    if(dimLevel != 0)               // Run the PWM engine during the tones
+    {
+        pwm_brightness((unsigned char)dimLevel);
+        pwm_set(0xF1, 16);          // D1 and D2-D5 on
+    }
+
+    printf("Tone pitch and length (interrupt latency %u cycles", sim_isr_cycles);
+    if(dimLevel != 0)
+        printf(", LEDs dimmed to %d/16", dimLevel);
+    printf(")\n");
+    printf("%-12s %10s %11s %8s %9s %11s %8s %6s\n", "tone", "nominal Hz",
+           "measured Hz", "cents", "jitter us", "cycles", "ms", "req ms");
+    for(i = NOTE_FIRST; i <= NOTE_LAST; i++)   // Every note in the table
+    {
+        char name[16];
+        uint64_t start = sim_now;
+
+        capture_start();
+        play_note((unsigned char)i, NOTE_MS);
+        snprintf(name, sizeof(name), "%s%u (%u)", noteNames[i % 12], i / 12 - 1, i);
+        report_tone(name, 440.0 * pow(2.0, ((int)i - 69) / 12.0), NOTE_MS, sim_now - start);
+        sim_delay(10 * SIM_CYCLES_PER_MS);
+    }
+    for(i = 0; i != sizeof(sounds) / sizeof(sounds[0]); i++)
+    {
+        char name[16];
+        uint64_t start = sim_now;
+
+        capture_start();
+        sound(sounds[i].num);
+        while(tone_busy())
+        {
+            sim_wait_event();
+        }
+        snprintf(name, sizeof(name), "sound(%u)", sounds[i].num);
+        report_tone(name, sounds[i].nominal, sounds[i].duration, sim_now - start);
+        sim_delay(10 * SIM_CYCLES_PER_MS);
+    }
+
+    // Stop a tone with interrupts off just as Timer1 overflows, so the
+    // overflow is still pending when they come back on: the beeper must stay
+    // off and the timer stopped
+    sim_sfr[SFR_INTCON] &= ~0x80;   // di()
+    tone_start(1000, 100);
+    while(!(sim_sfr[SFR_PIR1] & 0x01))  // TMR1IF
+    {
+        sim_wait_event();
+    }
+    tone_stop();
+    capture_start();
+    sim_ei();
+    sim_delay(10 * SIM_CYCLES_PER_MS);
+    printf("%-12s %lu beeper edges after stopping with an overflow pending %s\n",
+           "tone_stop()", edges, edges != 0 || (sim_sfr[SFR_T1CON] & 0x01) ? "FAIL" : "");
+    if(edges != 0 || (sim_sfr[SFR_T1CON] & 0x01))
+    {
+        failures++;
+    }
+
+    pwm_set(0xF1, 0);               // LEDs off for the function timing
+    pwm_brightness(16);
+
+    printf("\nFunction timing\n");
+    printf("%-16s %14s %12s\n", "function", "cycles", "ms");
+    report_call("power-up beep", time_call(power_up_beep));
+    report_call("start song", time_call(start_song));
+    report_call("win song", time_call(win_song));
+    report_call("lose, score 39", time_call(lose_39));
+    report_call("replay 42 steps", time_call(replay_42));
+
+    sim_halt(SIM_HALT_ASLEEP);
+    return(0);
+}
+
+int main(int argc, char **argv)
+{
+    int i;
+    int halt;
+
+    sim_isr_cycles = 20;
+    for(i = 1; i < argc; i++)
+    {
+        if(argv[i][0] == '-' && argv[i][1] == 'l' && i + 1 < argc)
+            sim_isr_cycles = (uint32_t)atoi(argv[++i]);
+        else if(argv[i][0] == '-' && argv[i][1] == 'c' && i + 1 < argc)
+            maxCents = atof(argv[++i]);
+        else if(argv[i][0] == '-' && argv[i][1] == 'd' && i + 1 < argc)
+            dimLevel = atoi(argv[++i]);
+        else
+        {
+            fprintf(stderr, "usage: %s [-l cycles] [-c cents] [-d level]\n", argv[0]);
+            return(2);
+        }
+    }
+
+    sim_reset();
+    sim_hooks.output = bench_output;
+    halt = sim_run(bench_main);
+    if(halt != SIM_HALT_ASLEEP)
+    {
+        fprintf(stderr, "benchmark halted early (reason %d)\n", halt);
+        return(1);
+    }
+    if(failures != 0)
+    {
+        fprintf(stderr, "%d tone(s) outside limits\n", failures);
+        return(1);
+    }
+    return(0);
+}
@@ -0,0 +1,217 @@
+/*==============================================================================
+ File: sim/simon-energy.c
+ Date: October 16, 2026
+
+ Power profile of UBMP4-Simon-Game sessions
+
+ Plays games against the scripted player with the energy model (energy.h)
+ attached, and reports the charge used by each load - the processor awake
+ and asleep, the watchdog, the ADC, the beeper and each LED - and in each
+ game state (sampled from the firmware's mode and state at least every
+ millisecond of a game), over the session and per game, with an estimate of
+ the games and standby time a battery gives. Comparing reports before and after a firmware change shows
+ what a power feature or timing change saves before it is built.
+
+ Each game is counted from the end of the one before (or power-up) to the
+ board going back to sleep, so the nap before the wake-up press is included.
+
+ Usage: simon-energy [-g games] [-f round] [-i round] [-k] [-l light] [-r]
+                     [-s seed] [-a load=mA] [-c mAh] [-v]
+   -a load=mA  set the current of a load (cpu48, cpu16, sleep, wdt, adc,
+               beeper, d1, led2-led5, or leds for all four); repeatable
+   -c mAh      battery capacity for the estimates (default 1000)
+   -v          print the charge of each game
+   Other options are as for simon-sim.
+==============================================================================*/
+
+#include    <stdio.h>
+#include    <stdlib.h>
+
+#include    "sim.h"
+#include    "simon-player.h"
+#include    "energy.h"
+
+extern int simon_main(void);        // Renamed firmware main()
+extern unsigned char mode, state;   // Firmware game mode and state
+
+#define CYCLES_PER_S    (SIM_CYCLES_PER_MS * 1000.0)
+#define STATES      11              // Game states 0-9, and off
+#define STATE_OFF   10
+#define SAMPLE      SIM_CYCLES_PER_MS   // State sampling period in a game
+
+static const char *stateName[STATES] =
+{
+    "turnWait", "playStep", "playGap", "getGuess", "showGuess", "showMiss",
+    "loseWait", "showStart", "showLose", "showEnd", "off"
+};
+
+static player_t player;
+static energy_t energy;
+static int verbose = 0;
+
+// Per game totals
+static uint64_t (*nextInput)(void *, uint64_t);
+static void (*nextSleep)(void *, uint64_t);
+static int gamesSeen = 0;
+static double gameStartMah = 0;
+static uint64_t gameStart = 0;
+static double minMah = 0, maxMah = 0;
+static double loadStart[ENERGY_LOADS];     // Charge of each load at the game start
+
+// Find the load that used the most charge since start[].
+static int top_load(const double *start)
+{
+    int top = 0;
+    int i;
+
+    for(i = 1; i != ENERGY_LOADS; i++)
+    {
+        if(energy_mah(&energy, i) - start[i] > energy_mah(&energy, top) - start[top])
+        {
+            top = i;
+        }
+    }
+    return(top);
+}
+
+// The game state the firmware is in, for the charge breakdown.
+static int game_state(void)
+{
+    return((mode == 0) ? STATE_OFF : (state < STATE_OFF ? state : STATE_OFF));
+}
+
+// Sample the energy model at least every SAMPLE during a game, so a state
+// that ends without an output change is still charged its own time.
+static uint64_t game_input(void *ctx, uint64_t now)
+{
+    uint64_t next = nextInput(ctx, now);   // Energy model, then the player
+
+    if(game_state() != STATE_OFF && now + SAMPLE < next)
+    {
+        next = now + SAMPLE;
+    }
+    return(next);
+}
+
+static void game_sleep(void *ctx, uint64_t now)
+{
+    double mAh;
+    double seconds;
+    int top;
+    int i;
+
+    nextSleep(ctx, now);            // Energy model, then the player
+    if(player.played == gamesSeen)
+    {
+        return;
+    }
+    gamesSeen = player.played;
+    mAh = energy_mah(&energy, ENERGY_LOADS) - gameStartMah;
+    seconds = (now - gameStart) / CYCLES_PER_S;
+    if(gamesSeen == 1 || mAh < minMah)
+        minMah = mAh;
+    if(gamesSeen == 1 || mAh > maxMah)
+        maxMah = mAh;
+    if(verbose)
+    {
+        top = top_load(loadStart);
+        printf("game %d energy: %.5f mAh in %.1f s (mean %.3f mA), most by %s (%.0f%%)\n",
+               gamesSeen, mAh, seconds, seconds > 0 ? mAh * 3600 / seconds : 0.0,
+               energy_name[top], mAh > 0 ? 100 * (energy_mah(&energy, top) - loadStart[top]) / mAh : 0.0);
+    }
+    gameStartMah += mAh;
+    gameStart = now;
+    for(i = 0; i != ENERGY_LOADS; i++)
+    {
+        loadStart[i] = energy_mah(&energy, i);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    int games = 100;
+    int failRound = 0;
+    int idleRound = 0;
+    int randomFail = 0;
+    int skipLose = 0;
+    int light = 1023;
+    unsigned int seed = 1;
+    double capacity = 1000;
+    double perGame;
+    double standby;
+    int halt;
+    int i;
+
+    energy_init(&energy);
+    for(i = 1; i < argc; i++)
+    {
+        if(argv[i][0] == '-' && argv[i][1] == 'g' && i + 1 < argc)
+            games = atoi(argv[++i]);
+        else if(argv[i][0] == '-' && argv[i][1] == 'f' && i + 1 < argc)
+            failRound = atoi(argv[++i]);
+        else if(argv[i][0] == '-' && argv[i][1] == 'i' && i + 1 < argc)
+            idleRound = atoi(argv[++i]);
+        else if(argv[i][0] == '-' && argv[i][1] == 'k')
+            skipLose = 1;
+        else if(argv[i][0] == '-' && argv[i][1] == 'l' && i + 1 < argc)
+            light = atoi(argv[++i]);
+        else if(argv[i][0] == '-' && argv[i][1] == 's' && i + 1 < argc)
+            seed = (unsigned int)strtoul(argv[++i], NULL, 0);
+        else if(argv[i][0] == '-' && argv[i][1] == 'r')
+            randomFail = 1;
+        else if(argv[i][0] == '-' && argv[i][1] == 'a' && i + 1 < argc && energy_set(&energy, argv[i + 1]) == 0)
+            i++;
+        else if(argv[i][0] == '-' && argv[i][1] == 'c' && i + 1 < argc)
+            capacity = atof(argv[++i]);
+        else if(argv[i][0] == '-' && argv[i][1] == 'v')
+            verbose = 1;
+        else
+        {
+            fprintf(stderr, "usage: %s [-g games] [-f round] [-i round] [-k] [-l light] [-r] [-s seed] [-a load=mA] [-c mAh] [-v]\n", argv[0]);
+            return(2);
+        }
+    }
+
+    player_init(&player, games, seed);
+    player.failRound = failRound;
+    player.idleRound = idleRound;
+    player.randomFail = randomFail;
+    player.skipLose = skipLose;
+    player.verbose = verbose;
+
+    sim_reset();
+    sim_analog[7] = (uint16_t)light;    // Q1 (AN7)
+    player_attach(&player);
+    energy_attach(&energy);
+    energy_parts(&energy, game_state, stateName, STATES);
+    nextInput = sim_hooks.input;
+    sim_hooks.input = game_input;
+    nextSleep = sim_hooks.sleep;
+    sim_hooks.sleep = game_sleep;
+    halt = sim_run(simon_main);
+    energy_sample(&energy, sim_now);
+
+    player_report(&player, stdout);
+    energy_report(&energy, player.played, stdout);
+    if(player.played != 0)
+    {
+        printf("game range:    %.5f to %.5f mAh\n", minMah, maxMah);
+    }
+
+    // Battery estimates: games played back to back, and asleep between games
+    perGame = player.played ? energy_mah(&energy, ENERGY_LOADS) / player.played : 0;
+    standby = energy.current[ENERGY_SLEEP];
+    printf("battery:       %.0f mAh", capacity);
+    if(perGame > 0)
+        printf(", %.0f games", capacity / perGame);
+    if(standby > 0)
+        printf(", %.0f days asleep", capacity / standby / 24);
+    printf("\n");
+
+    if(halt != SIM_HALT_ASLEEP)
+    {
+        fprintf(stderr, "simulation halted early (reason %d)\n", halt);
+        return(1);
+    }
+    return(player.errors != 0);
+}
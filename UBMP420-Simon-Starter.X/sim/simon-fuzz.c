@@ -0,0 +1,545 @@
+/*==============================================================================
+ File: sim/simon-fuzz.c
+ Date: October 16, 2026
+
+ Coverage-guided fuzzer for the UBMP4-Simon-Game state machine
+
+ Drives the game firmware on the simulated board with arbitrary button and
+ timing streams, built with AddressSanitizer and UndefinedBehaviorSanitizer,
+ to find out-of-bounds pattern accesses, unsigned underflows in the score and
+ states the game can't get out of. An input is:
+
+    byte 0      Q1 light level (ADC reading = byte * 4 + 3)
+    bytes 1-2   firmware random generator seed (randomSeed, low byte first)
+    then pairs  buttons held (bits 0-3 = SW2-SW5) and the time until the
+                next pair: 0-199 ms, or (byte - 199) s from 200 up
+
+ After the last pair the buttons are released and the game must go back to
+ sleep by itself. Besides the sanitizers, the game's variables are checked
+ on every output change and input event: mode and state must be valid,
+ step can't pass maxStep while the pattern is played or matched, maxStep can't pass patternLength, and the best
+ score saved can't be more than patternLength (an underflowed score would
+ be 65535). The fuzz build makes patternLength short (FUZZ_PATTERN in the
+ Makefile) so that the win and the end of the pattern memory are in reach.
+
+ The firmware keeps its state in C globals, so each input runs in a fresh
+ fork()ed process (as simon-batch runs boards). The firmware objects are
+ built with -fsanitize-coverage=trace-pc, and the hook below counts edges
+ between the code blocks they run in a map shared with the fuzzer. Inputs
+ that reach new edges (or new hit counts) join the corpus and are mutated
+ further. An input that crashes, trips a check or hangs is saved as
+ crash-<hash> and ends the run; replaying the file runs it again in this
+ process, with -v printing every input event and state change up to the
+ failure.
+
+ Usage: simon-fuzz [-n runs] [-s seed] [-m bytes] [-c dir] [-v]
+        simon-fuzz [-v] file
+   -n runs   inputs to try (default 10000)
+   -s seed   mutation random seed (default 1)
+   -m bytes  longest input made (default 128)
+   -c dir    corpus directory: inputs in it are run first, and inputs that
+             reach new edges are saved there
+   -v        print the corpus growth, or trace the replayed file
+==============================================================================*/
+
+#include    <stdio.h>
+#include    <stdlib.h>
+#include    <string.h>
+#include    <stdarg.h>
+#include    <time.h>
+#include    <dirent.h>
+#include    <unistd.h>
+#include    <sys/mman.h>
+#include    <sys/wait.h>
+
+#include    "sim.h"
+#include    "../UBMP420-stats.h"
+
+extern int simon_main(void);        // Renamed firmware main()
+extern uint16_t randomSeed;         // Firmware random generator state
+extern unsigned char mode, state;   // Firmware game mode and state
+extern uint16_t step, maxStep;      // Firmware pattern step and length
+
+#ifndef patternLength
+#define patternLength 42            // As in UBMP4-Simon-Game.c
+#endif
+
+#define MAP_SIZE    65536           // Edge coverage map entries
+#define CORPUS_MAX  4096            // Most inputs kept in the corpus
+#define HEADER      3               // Light and seed bytes
+#define SETTLE      (300 * 1000 * SIM_CYCLES_PER_MS)    // Time to go back to
+                                    // sleep after the last event (> timeOut)
+#define WALL_LIMIT  20              // Wall time limit for one input (s)
+
+static const char *stateName[] =
+{
+    "turnWait", "playStep", "playGap", "getGuess", "showGuess", "showMiss",
+    "loseWait", "showStart", "showLose", "showEnd"
+};
+
+static const char *haltName[] =
+{
+    "none", "asleep", "reset", "stuck", "time limit", "ISR", "power"
+};
+
+// Edge coverage, written by the instrumented firmware in the input's process
+static uint8_t *coverage;
+static uintptr_t lastBlock;
+
+void __sanitizer_cov_trace_pc(void)
+{
+    uintptr_t block = (uintptr_t)__builtin_return_address(0);
+
+    block = (block ^ (block >> 15)) & (MAP_SIZE - 1);
+    if(coverage != NULL)
+    {
+        coverage[block ^ lastBlock]++;
+    }
+    lastBlock = block >> 1;
+}
+
+// Input being run
+static const uint8_t *input;
+static size_t inputSize;
+static size_t inputPos;
+static int verbose = 0;
+static int lastMode, lastState;
+static unsigned int lastMaxStep;
+
+static void fuzz_fail(const char *format, ...)
+{
+    va_list args;
+
+    fprintf(stderr, "%10.3f ms  FAIL: ", sim_now / (double)SIM_CYCLES_PER_MS);
+    va_start(args, format);
+    vfprintf(stderr, format, args);
+    va_end(args);
+    fputc('\n', stderr);
+    abort();
+}
+
+// Check the game's variables, and trace their changes.
+static void fuzz_check(uint64_t now)
+{
+    if(mode > 1)
+        fuzz_fail("mode %u", mode);
+    if(state >= sizeof(stateName) / sizeof(stateName[0]))
+        fuzz_fail("state %u", state);
+    if(maxStep > patternLength)
+        fuzz_fail("maxStep %u > patternLength %u", maxStep, patternLength);
+    if(mode != 0 && state >= 1 && state <= 4 && step > maxStep)  // playStep-showGuess
+        fuzz_fail("step %u > maxStep %u", step, maxStep);
+    if(stats_read()->bestScore > patternLength)
+        fuzz_fail("best score %u > patternLength %u", stats_read()->bestScore, patternLength);
+
+    if(verbose && (mode != lastMode || state != lastState || maxStep != lastMaxStep))
+    {
+        printf("%10.3f ms  %s %s, maxStep %u, step %u\n", now / (double)SIM_CYCLES_PER_MS,
+               mode ? "simon" : "off", stateName[state], maxStep, step);
+    }
+    lastMode = mode;
+    lastState = state;
+    lastMaxStep = maxStep;
+}
+
+static uint64_t fuzz_input(void *ctx, uint64_t now)
+{
+    uint8_t buttons;
+    uint8_t wait;
+    uint64_t ms;
+
+    fuzz_check(now);
+    if(inputPos + 2 > inputSize)
+    {
+        sim_set_pins(1, 0xF0, 0xF0);    // Release SW2-SW5
+        if(verbose && inputPos != inputSize + 2)
+            printf("%10.3f ms  release all, end of input\n", now / (double)SIM_CYCLES_PER_MS);
+        inputPos = inputSize + 2;
+        return(SIM_NEVER);
+    }
+    buttons = input[inputPos] & 0x0F;
+    wait = input[inputPos + 1];
+    inputPos += 2;
+    ms = wait < 200 ? wait : (uint64_t)(wait - 199) * 1000;
+
+    sim_set_pins(1, 0xF0, (uint8_t)((~buttons & 0x0F) << 4));
+    if(verbose)
+    {
+        printf("%10.3f ms  buttons%s%s%s%s%s, next in %llu ms\n", now / (double)SIM_CYCLES_PER_MS,
+               buttons & 1 ? " SW2" : "", buttons & 2 ? " SW3" : "", buttons & 4 ? " SW4" : "",
+               buttons & 8 ? " SW5" : "", buttons ? "" : " none", (unsigned long long)ms);
+    }
+    return(now + ms * SIM_CYCLES_PER_MS);
+}
+
+static void fuzz_output(void *ctx, uint64_t now, uint8_t lata, uint8_t latc)
+{
+    fuzz_check(now);
+}
+
+// Run one input on a new board. Returns only if the game passed.
+static void fuzz_run(const uint8_t *data, size_t size)
+{
+    uint64_t length = 0;
+    size_t i;
+    int halt;
+
+    input = data;
+    inputSize = size;
+    inputPos = HEADER;
+    lastMode = -1;
+
+    for(i = HEADER; i + 2 <= size; i += 2)
+    {
+        length += data[i + 1] < 200 ? data[i + 1] : (uint64_t)(data[i + 1] - 199) * 1000;
+    }
+
+    sim_flash_blank();
+    sim_reset();
+    sim_analog[7] = (uint16_t)((size > 0 ? data[0] : 255) * 4 + 3);     // Q1 (AN7)
+    randomSeed = size >= HEADER ? (unsigned int)(data[1] | (data[2] << 8)) : 0;
+    sim_limit = length * SIM_CYCLES_PER_MS + SETTLE;
+    sim_hooks.input = fuzz_input;
+    sim_hooks.output = fuzz_output;
+    sim_hooks.sleep = NULL;
+    sim_schedule_input(0);
+    if(verbose)
+    {
+        printf("light %u, seed 0x%04X, %zu events, %.3f s\n", sim_analog[7], randomSeed,
+               size > HEADER ? (size - HEADER) / 2 : 0, length / 1000.0);
+    }
+
+    halt = sim_run(simon_main);
+    fuzz_check(sim_now);
+    if(halt != SIM_HALT_ASLEEP)
+        fuzz_fail("halted: %s", haltName[halt]);
+    if(mode != 0)
+        fuzz_fail("asleep with the game on");
+    if(verbose)
+        printf("%10.3f ms  asleep: pass\n", sim_now / (double)SIM_CYCLES_PER_MS);
+}
+
+// Fuzzer state (parent process)
+typedef struct
+{
+    uint8_t *data;
+    size_t size;
+} entry_t;
+
+static entry_t corpus[CORPUS_MAX];
+static int corpusCount = 0;
+static uint8_t edges[MAP_SIZE];     // Hit count classes seen for each edge
+static int edgeCount = 0;
+static uint64_t rng = 1;
+
+static uint32_t fuzz_random(uint32_t n)
+{
+    rng ^= rng << 13;
+    rng ^= rng >> 7;
+    rng ^= rng << 17;
+    return((uint32_t)(rng >> 32) % n);
+}
+
+static uint64_t hash(const uint8_t *data, size_t size)
+{
+    uint64_t h = 0xCBF29CE484222325ULL;     // FNV-1a
+    size_t i;
+
+    for(i = 0; i != size; i++)
+    {
+        h = (h ^ data[i]) * 0x100000001B3ULL;
+    }
+    return(h);
+}
+
+static int save(const char *dir, const char *prefix, const uint8_t *data, size_t size)
+{
+    char path[1024];
+    FILE *out;
+
+    snprintf(path, sizeof(path), "%s%s%s%016llx", dir ? dir : "", dir ? "/" : "",
+             prefix, (unsigned long long)hash(data, size));
+    out = fopen(path, "wb");
+    if(out == NULL || fwrite(data, 1, size, out) != size || fclose(out) != 0)
+    {
+        perror(path);
+        return(-1);
+    }
+    if(dir == NULL)
+        printf("saved %s\n", path);
+    return(0);
+}
+
+static size_t load(const char *path, uint8_t *data, size_t max)
+{
+    FILE *in = fopen(path, "rb");
+    size_t size;
+
+    if(in == NULL)
+    {
+        perror(path);
+        return(0);
+    }
+    size = fread(data, 1, max, in);
+    fclose(in);
+    return(size);
+}
+
+// Hit count class of an edge (1, 2, 3, 4-7, 8-15, 16-31, 32-127, 128+).
+static uint8_t hit_class(uint8_t hits)
+{
+    if(hits < 4)
+        return((uint8_t)(1 << (hits - 1)));
+    if(hits < 8)
+        return(8);
+    if(hits < 16)
+        return(16);
+    if(hits < 32)
+        return(32);
+    return(hits < 128 ? 64 : 128);
+}
+
+// Run one input in a new process. Returns 1 if it failed, 0 if it passed,
+// and counts the new edges it reached in *found.
+static int execute(const uint8_t *data, size_t size, int *found)
+{
+    pid_t pid;
+    int status;
+    int i;
+
+    memset(coverage, 0, MAP_SIZE);
+    fflush(stdout);
+    fflush(stderr);
+    pid = fork();
+    if(pid == 0)
+    {
+        alarm(WALL_LIMIT);
+        fuzz_run(data, size);
+        _exit(0);
+    }
+    if(pid < 0)
+    {
+        perror("fork");
+        exit(2);
+    }
+    waitpid(pid, &status, 0);
+
+    *found = 0;
+    for(i = 0; i != MAP_SIZE; i++)
+    {
+        if(coverage[i] != 0 && (edges[i] & hit_class(coverage[i])) == 0)
+        {
+            edgeCount += edges[i] == 0;
+            edges[i] |= hit_class(coverage[i]);
+            (*found)++;
+        }
+    }
+    return(!(WIFEXITED(status) && WEXITSTATUS(status) == 0));
+}
+
+// Make a new input from a corpus entry.
+static size_t mutate(uint8_t *data, size_t max)
+{
+    const entry_t *e = &corpus[fuzz_random((uint32_t)corpusCount)];
+    const entry_t *other;
+    size_t size = e->size < max ? e->size : max;
+    size_t at, len;
+    int n = 1 + (int)fuzz_random(4);
+
+    memcpy(data, e->data, size);
+    while(size < HEADER)
+    {
+        data[size++] = 0xFF;
+    }
+    while(n-- != 0)
+    {
+        at = HEADER + 2 * fuzz_random((uint32_t)(size - HEADER) / 2 + 1);
+        switch(fuzz_random(7))
+        {
+            case 0:                 // Flip a bit
+                if(size != 0)
+                    data[fuzz_random((uint32_t)size)] ^= (uint8_t)(1 << fuzz_random(8));
+                break;
+            case 1:                 // Change a byte
+                if(size != 0)
+                    data[fuzz_random((uint32_t)size)] = (uint8_t)fuzz_random(256);
+                break;
+            case 2:                 // Insert an event
+                if(size + 2 <= max)
+                {
+                    memmove(data + at + 2, data + at, size - at);
+                    data[at] = (uint8_t)fuzz_random(16);
+                    data[at + 1] = (uint8_t)fuzz_random(256);
+                    size += 2;
+                }
+                break;
+            case 3:                 // Delete an event
+                if(at + 2 <= size)
+                {
+                    memmove(data + at, data + at + 2, size - at - 2);
+                    size -= 2;
+                }
+                break;
+            case 4:                 // Repeat a run of events
+                len = 2 * (1 + fuzz_random(8));
+                if(at + len <= size && size + len <= max)
+                {
+                    memmove(data + at + len, data + at, size - at);
+                    size += len;
+                }
+                break;
+            case 5:                 // Short wait (a quick press or release)
+                if(at + 2 <= size)
+                    data[at + 1] = (uint8_t)fuzz_random(100);
+                break;
+            default:                // Splice in the tail of another input
+                other = &corpus[fuzz_random((uint32_t)corpusCount)];
+                if(other->size > at)
+                {
+                    len = other->size - at;
+                    len = at + len <= max ? len : max - at;
+                    memcpy(data + at, other->data + at, len);
+                    size = at + len;
+                }
+                break;
+        }
+    }
+    return(size);
+}
+
+static void keep(const uint8_t *data, size_t size, const char *dir)
+{
+    if(corpusCount == CORPUS_MAX)
+        return;
+    corpus[corpusCount].data = malloc(size + 1);
+    memcpy(corpus[corpusCount].data, data, size);
+    corpus[corpusCount].size = size;
+    corpusCount++;
+    if(dir != NULL)
+        save(dir, "", data, size);
+}
+
+int main(int argc, char **argv)
+{
+    // Seed input: wake the board, then press SW2 in each turn
+    static const uint8_t first[] = {255, 0, 0, 1, 100, 0, 250, 1, 100, 0, 203};
+    uint8_t *data;
+    const char *replay = NULL;
+    const char *dir = NULL;
+    long runs = 10000;
+    size_t max = 128;
+    size_t size;
+    long run;
+    long crashes = 0;
+    int found;
+    struct timespec t0, t1;
+    double wall;
+    int i;
+
+    for(i = 1; i < argc; i++)
+    {
+        if(argv[i][0] == '-' && argv[i][1] == 'n' && i + 1 < argc)
+            runs = atol(argv[++i]);
+        else if(argv[i][0] == '-' && argv[i][1] == 's' && i + 1 < argc)
+            rng = strtoull(argv[++i], NULL, 0) | 1;
+        else if(argv[i][0] == '-' && argv[i][1] == 'm' && i + 1 < argc)
+            max = (size_t)atol(argv[++i]);
+        else if(argv[i][0] == '-' && argv[i][1] == 'c' && i + 1 < argc)
+            dir = argv[++i];
+        else if(argv[i][0] == '-' && argv[i][1] == 'v')
+            verbose = 1;
+        else if(argv[i][0] != '-' && replay == NULL)
+            replay = argv[i];
+        else
+        {
+            fprintf(stderr, "usage: %s [-n runs] [-s seed] [-m bytes] [-c dir] [-v]\n"
+                            "       %s [-v] file\n", argv[0], argv[0]);
+            return(2);
+        }
+    }
+    if(max < sizeof(first))
+        max = sizeof(first);
+    data = malloc(max > 65536 ? max : 65536);
+
+    // Replay one input in this process
+    if(replay != NULL)
+    {
+        size = load(replay, data, 65536);
+        setvbuf(stdout, NULL, _IOLBF, 0);   // Trace up to a crash or hang
+        alarm(WALL_LIMIT);
+        fuzz_run(data, size);
+        printf("%s: pass\n", replay);
+        free(data);
+        return(0);
+    }
+
+    coverage = mmap(NULL, MAP_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if(coverage == MAP_FAILED)
+    {
+        perror("mmap");
+        return(2);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+
+    // Start from the corpus directory and the built-in seed input
+    if(dir != NULL)
+    {
+        DIR *d = opendir(dir);
+        struct dirent *f;
+        char path[1024];
+
+        while(d != NULL && (f = readdir(d)) != NULL)
+        {
+            if(f->d_name[0] == '.')
+                continue;
+            snprintf(path, sizeof(path), "%s/%s", dir, f->d_name);
+            size = load(path, data, max);
+            if(execute(data, size, &found))
+            {
+                fprintf(stderr, "%s fails\n", path);
+                crashes++;
+            }
+            else if(found != 0)
+                keep(data, size, NULL);
+        }
+        if(d != NULL)
+            closedir(d);
+    }
+    if(execute(first, sizeof(first), &found))
+    {
+        fprintf(stderr, "seed input fails\n");
+        crashes++;
+    }
+    keep(first, sizeof(first), NULL);
+
+    for(run = 1; run <= runs; run++)
+    {
+        size = mutate(data, max);
+        if(execute(data, size, &found))
+        {
+            crashes++;
+            save(NULL, "crash-", data, size);
+            printf("replay with:   %s -v crash-%016llx\n", argv[0],
+                   (unsigned long long)hash(data, size));
+            break;
+        }
+        else if(found != 0)
+        {
+            keep(data, size, dir);
+            if(verbose)
+                printf("run %ld: %d edges, corpus %d\n", run, edgeCount, corpusCount);
+        }
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    wall = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9;
+    run = run > runs ? runs : run;
+    printf("runs:          %ld (%.0f/s)\n", run, run / wall);
+    printf("edges:         %d\n", edgeCount);
+    printf("corpus:        %d inputs\n", corpusCount);
+    printf("crashes:       %ld\n", crashes);
+    while(corpusCount != 0)
+        free(corpus[--corpusCount].data);
+    free(data);
+    return(crashes != 0);
+}
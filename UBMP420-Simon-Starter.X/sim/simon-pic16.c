@@ -0,0 +1,127 @@
+/*==============================================================================
+ File: sim/simon-pic16.c
+ Date: October 16, 2026
+
+ Instruction-level runner for the built UBMP4-Simon-Game image
+
+ Loads the .hex file produced by the MPLAB X project (the bytes that get
+ programmed into the PIC) and runs it on the PIC16 emulator and simulated
+ board, against the same scripted player as simon-sim. Besides the game
+ results it reports the emulator's instruction and interrupt counts and its
+ speed in MIPS (millions of PIC instructions per second of wall time,
+ counting instructions in skipped waiting and delay loops).
+
+ Usage: simon-pic16 [-g games] [-f round] [-i round] [-k] [-l light] [-r]
+                    [-s seed] [-n] [-v] image.hex
+   -n        run every pass of waiting and delay loops (no skipping)
+   Other options are as for simon-sim.
+==============================================================================*/
+
+#include    <stdio.h>
+#include    <stdlib.h>
+#include    <time.h>
+
+#include    "sim.h"
+#include    "pic16.h"
+#include    "simon-player.h"
+
+int main(int argc, char **argv)
+{
+    player_t player;
+    int games = 100;
+    int failRound = 0;
+    int idleRound = 0;
+    int randomFail = 0;
+    int skipLose = 0;
+    int light = 1023;
+    unsigned int seed = 1;
+    int verbose = 0;
+    const char *image = NULL;
+    int words;
+    int i;
+    int halt;
+    struct timespec t0, t1;
+    double wall;
+    double mips;
+
+    for(i = 1; i < argc; i++)
+    {
+        if(argv[i][0] == '-' && argv[i][1] == 'g' && i + 1 < argc)
+            games = atoi(argv[++i]);
+        else if(argv[i][0] == '-' && argv[i][1] == 'f' && i + 1 < argc)
+            failRound = atoi(argv[++i]);
+        else if(argv[i][0] == '-' && argv[i][1] == 'i' && i + 1 < argc)
+            idleRound = atoi(argv[++i]);
+        else if(argv[i][0] == '-' && argv[i][1] == 'k')
+            skipLose = 1;
+        else if(argv[i][0] == '-' && argv[i][1] == 'l' && i + 1 < argc)
+            light = atoi(argv[++i]);
+        else if(argv[i][0] == '-' && argv[i][1] == 's' && i + 1 < argc)
+            seed = (unsigned int)strtoul(argv[++i], NULL, 0);
+        else if(argv[i][0] == '-' && argv[i][1] == 'r')
+            randomFail = 1;
+        else if(argv[i][0] == '-' && argv[i][1] == 'n')
+            pic16_skip = false;
+        else if(argv[i][0] == '-' && argv[i][1] == 'v')
+            verbose = 1;
+        else if(argv[i][0] != '-' && image == NULL)
+            image = argv[i];
+        else
+        {
+            image = NULL;
+            break;
+        }
+    }
+    if(image == NULL)
+    {
+        fprintf(stderr, "usage: %s [-g games] [-f round] [-i round] [-k] [-l light] [-r] [-s seed] [-n] [-v] image.hex\n", argv[0]);
+        return(2);
+    }
+
+    words = pic16_load_hex(image);
+    if(words <= 0)
+    {
+        fprintf(stderr, "%s: can't load %s\n", argv[0], image);
+        return(2);
+    }
+    printf("image:         %s, %d words, reset vector 0x%04X\n", image, words, pic16_offset);
+
+    player_init(&player, games, seed);
+    player.failRound = failRound;
+    player.idleRound = idleRound;
+    player.randomFail = randomFail;
+    player.skipLose = skipLose;
+    player.verbose = verbose;
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    sim_reset();
+    sim_analog[7] = (uint16_t)light;    // Q1 (AN7)
+    player_attach(&player);
+    halt = sim_run(pic16_run);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    wall = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9;
+    mips = (pic16_stats.instructions + pic16_stats.skipped) / wall / 1e6;
+
+    player_report(&player, stdout);
+    printf("instructions:  %llu executed, %llu skipped in loops, %llu interrupts\n",
+           (unsigned long long)pic16_stats.instructions,
+           (unsigned long long)pic16_stats.skipped,
+           (unsigned long long)pic16_stats.interrupts);
+    printf("virtual time:  %.1f s (%.1f s asleep)\n",
+           (double)sim_now / (SIM_CYCLES_PER_MS * 1000.0),
+           (double)sim_sleep_cycles / (SIM_CYCLES_PER_MS * 1000.0));
+    printf("wall time:     %.3f s (%.0f MIPS, %.0fx real time)\n",
+           wall, mips, sim_now / (SIM_CYCLES_PER_MS * 1000.0) / wall);
+
+    if(pic16_stats.stackErrors != 0)
+    {
+        fprintf(stderr, "return stack overflow or underflow\n");
+        return(1);
+    }
+    if(halt != SIM_HALT_ASLEEP)
+    {
+        fprintf(stderr, "simulation halted early (reason %d)\n", halt);
+        return(1);
+    }
+    return(player.errors != 0);
+}
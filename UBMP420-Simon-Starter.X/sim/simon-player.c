@@ -0,0 +1,401 @@
+/*==============================================================================
+ File: sim/simon-player.c
+ Date: October 16, 2026
+
+ Scripted Simon player for the UBMP4.2 host simulator
+
+ Timing rules the player relies on (from UBMP4-Simon-Game.c):
+ * steps of one pattern are separated by a 500 ms gap with the LEDs off,
+ * each new turn starts at least 1000 ms after the previous one,
+ * the first guess is timed from 500 ms after the last pattern step, and
+ * the game then waits for the player as long as it takes.
+ So an LED that lights more than TURN_GAP after the last one starts a new
+ pattern, and when the LEDs stay off for REPLAY_WAIT it is the player's turn.
+==============================================================================*/
+
+#include    "sim.h"
+#include    "simon-player.h"
+
+#define TURN_GAP        (750 * SIM_CYCLES_PER_MS)   // Longer gap: new pattern
+#define REPLAY_WAIT     (1200 * SIM_CYCLES_PER_MS)  // Quiet time: player's turn
+#define LED_PERSIST     (4 * SIM_CYCLES_PER_MS)     // Off time to see an LED off
+#define STEP_GAP        (500 * SIM_CYCLES_PER_MS)   // Pattern end to first guess
+
+// Player states
+#define P_BOOT      0               // Board booting, no game yet
+#define P_ASLEEP    1               // Board asleep, wake-up press scheduled
+#define P_WAKE      2               // Holding the wake-up button
+#define P_WATCH     3               // Watching the pattern play
+#define P_PRESS     4               // Next input: press the next button
+#define P_HOLD      5               // Next input: release the button
+#define P_ECHO      6               // Waiting for the guess LED to turn off
+#define P_DONE      7               // Finished this game, waiting for sleep
+
+static const char *resultName[] = {"none", "win", "lose", "timeout", "error"};
+
+// Player random number from min to max (inclusive).
+static uint32_t player_random(player_t *p, uint32_t min, uint32_t max)
+{
+    p->rng ^= p->rng << 13;
+    p->rng ^= p->rng >> 17;
+    p->rng ^= p->rng << 5;
+    return(min + p->rng % (max - min + 1));
+}
+
+static uint64_t player_ms(player_t *p, uint32_t min, uint32_t max)
+{
+    return((uint64_t)player_random(p, min, max) * SIM_CYCLES_PER_MS);
+}
+
+void player_init(player_t *p, int games, uint32_t seed)
+{
+    *p = (player_t){0};
+    p->games = games;
+    p->rng = seed ? seed : 1;
+    p->reactionMin = 1e9;
+    p->responseMin = 1e9;
+    p->state = P_BOOT;
+    p->due = SIM_NEVER;
+}
+
+// Ask for player_step() to run at time when (or earlier).
+static void player_schedule(player_t *p, uint64_t when)
+{
+    if(when < p->due)
+    {
+        p->due = when;
+    }
+    sim_schedule_input(when);
+}
+
+static void player_release(void)
+{
+    sim_set_pins(1, 0xF0, 0xF0);    // Release SW2-SW5
+}
+
+static void player_press(uint8_t button)
+{
+    sim_set_pins(1, 0x10 << (button - 1), 0x00);
+}
+
+// Time a guess press against the time the guess became available.
+static void player_reaction(player_t *p, uint64_t now)
+{
+    double ms = (double)(now - p->ready) / SIM_CYCLES_PER_MS;
+
+    p->reactions++;
+    p->reactionSum += ms;
+    if(ms < p->reactionMin)
+    {
+        p->reactionMin = ms;
+    }
+    if(ms > p->reactionMax)
+    {
+        p->reactionMax = ms;
+    }
+}
+
+// Count the result of the game that just ended.
+static void player_finish(player_t *p, uint64_t now)
+{
+    int result = p->result;
+
+    if(result == RESULT_NONE)
+    {
+        result = RESULT_ERROR;
+    }
+    p->played++;
+    p->wins += (result == RESULT_WIN);
+    p->losses += (result == RESULT_LOSE);
+    p->timeouts += (result == RESULT_TIMEOUT);
+    p->errors += (result == RESULT_ERROR);
+    p->rounds += p->round;
+    if(p->round > p->bestRound)
+    {
+        p->bestRound = p->round;
+    }
+    p->gameSeconds += (double)(now - p->gameStart) / (SIM_CYCLES_PER_MS * 1000.0);
+    if(p->verbose)
+    {
+        printf("game %d: %s after %d rounds, %.1f s\n", p->played,
+               resultName[result], p->round,
+               (double)(now - p->gameStart) / (SIM_CYCLES_PER_MS * 1000.0));
+    }
+}
+
+// Player state machine. Returns the time it wants to run next.
+static uint64_t player_step(player_t *p, uint64_t now)
+{
+    uint8_t button;
+
+    switch(p->state)
+    {
+    case P_DONE:                    // Lost: press to skip to a new game
+        player_finish(p, now);
+        p->state = P_ASLEEP;
+        if(p->played >= p->games)
+        {
+            return(SIM_NEVER);
+        }
+        /* fall through */
+
+    case P_ASLEEP:                  // Press SW2 to wake the board
+        p->seenCount = 0;
+        p->round = 0;
+        p->result = RESULT_NONE;
+        p->gameStart = now;
+        p->gameFail = p->randomFail ? (int)player_random(p, 1, 42) : p->failRound;
+        p->waking = !p->powerOn;    // (not when skipping to a new game)
+        player_press(1);
+        p->state = P_WAKE;
+        return(now + player_ms(p, 80, 150));
+
+    case P_WAKE:
+        player_release();
+        p->state = P_WATCH;
+        return(SIM_NEVER);
+
+    case P_WATCH:                   // Quiet long enough? Repeat the pattern
+        if(p->leds != 0 || p->seenCount == 0)
+        {
+            return(SIM_NEVER);
+        }
+        if(now - p->lastOff < REPLAY_WAIT)
+        {
+            return(p->lastOff + REPLAY_WAIT);
+        }
+        if(p->seenCount == p->idleRound)
+        {
+            p->result = RESULT_TIMEOUT;
+            p->state = P_DONE;
+            return(SIM_NEVER);
+        }
+        p->replay = 0;
+        /* fall through */
+
+    case P_PRESS:
+        button = p->seen[p->replay];
+        if(p->seenCount == p->gameFail && p->replay == p->seenCount - 1)
+        {
+            button = button % 4 + 1;    // Wrong button on purpose
+            p->result = RESULT_LOSE;
+        }
+        player_press(button);
+        player_reaction(p, now);
+        p->guessTime = now;
+        p->guessing = true;
+        p->state = P_HOLD;
+        return(now + player_ms(p, 40, 120));
+
+    case P_HOLD:
+        player_release();
+        if(p->result == RESULT_LOSE)
+        {
+            p->state = P_DONE;
+            if(p->skipLose)
+            {
+                return(now + player_ms(p, 800, 1200));
+            }
+        }
+        else if(++p->replay == p->seenCount)
+        {
+            p->round = p->seenCount;    // Whole pattern repeated
+            p->seenCount = 0;
+            p->state = P_WATCH;
+        }
+        else
+        {
+            p->state = P_ECHO;
+        }
+        return(SIM_NEVER);
+    }
+    return(SIM_NEVER);
+}
+
+// React to a change in the LEDs the player sees.
+static void player_leds(player_t *p, uint64_t now, uint8_t leds)
+{
+    uint8_t old = p->leds;
+
+    p->leds = leds;
+    if(leds == old)
+    {
+        return;
+    }
+
+    if(p->state == P_WATCH)
+    {
+        if(__builtin_popcount(leds) >= 3 && p->round > 0)
+        {
+            p->result = RESULT_WIN;     // All LEDs on: win sequence
+            p->state = P_DONE;
+        }
+        else if(old == 0 && __builtin_popcount(leds) == 1)
+        {
+            if(now - p->lastOff > TURN_GAP)
+            {
+                p->seenCount = 0;       // First step of a new pattern
+            }
+            if(p->seenCount < PLAYER_MAX_STEPS)
+            {
+                p->seen[p->seenCount++] = (uint8_t)__builtin_ctz(leds) + 1;
+            }
+        }
+    }
+
+    if(leds == 0)
+    {
+        p->lastOff = now;
+        if(p->state == P_WATCH && p->seenCount != 0)
+        {
+            p->ready = now + STEP_GAP;
+            player_schedule(p, now + REPLAY_WAIT);
+        }
+        else if(p->state == P_ECHO)
+        {
+            p->ready = now;
+            p->state = P_PRESS;
+            player_schedule(p, now + player_ms(p, 80, 150));
+        }
+    }
+}
+
+// Turn off the LEDs seen lit whose outputs have stayed off for LED_PERSIST.
+// Returns the time the next one can turn off.
+static uint64_t player_settle(player_t *p, uint64_t now)
+{
+    uint8_t leds = p->leds;
+    uint64_t next = SIM_NEVER;
+    int i;
+
+    for(i = 0; i != 4; i++)
+    {
+        if((leds & ~p->rawLeds) & (1 << i))
+        {
+            if(now - p->litTime[i] >= LED_PERSIST)
+            {
+                leds &= ~(1 << i);
+            }
+            else if(p->litTime[i] + LED_PERSIST < next)
+            {
+                next = p->litTime[i] + LED_PERSIST;
+            }
+        }
+    }
+    player_leds(p, now, leds);
+    return(next);
+}
+
+static uint64_t player_input(void *ctx, uint64_t now)
+{
+    player_t *p = ctx;
+    uint64_t next = player_settle(p, now);
+
+    if(now >= p->due)
+    {
+        p->due = SIM_NEVER;
+        player_schedule(p, player_step(p, now));
+    }
+    return(next < p->due ? next : p->due);
+}
+
+static void player_output(void *ctx, uint64_t now, uint8_t lata, uint8_t latc)
+{
+    player_t *p = ctx;
+    uint8_t raw = (latc >> 4) & 0x0F;
+    int i;
+
+    p->powerOn = !(lata & 0x20);    // LED1 is active-low
+    if(p->waking && p->powerOn)     // Power LED lit after the wake-up press
+    {
+        double us = (double)(now - p->gameStart) / SIM_CYCLES_PER_US;
+
+        p->waking = false;
+        p->wakes++;
+        p->wakeSum += us;
+        if(us > p->wakeMax)
+        {
+            p->wakeMax = us;
+        }
+    }
+    if(p->guessing && raw != 0)     // Guess LED lit after the press
+    {
+        double ms = (double)(now - p->guessTime) / SIM_CYCLES_PER_MS;
+
+        p->guessing = false;
+        p->responses++;
+        p->responseSum += ms;
+        if(ms < p->responseMin)
+        {
+            p->responseMin = ms;
+        }
+        if(ms > p->responseMax)
+        {
+            p->responseMax = ms;
+        }
+    }
+    p->rawLeds = raw;
+    for(i = 0; i != 4; i++)
+    {
+        if(raw & (1 << i))
+        {
+            p->litTime[i] = now;
+        }
+    }
+    player_leds(p, now, p->leds | raw); // LEDs are seen as soon as they light
+    if(p->leds & ~raw)
+    {
+        sim_schedule_input(player_settle(p, now));
+    }
+}
+
+static void player_sleep(void *ctx, uint64_t now)
+{
+    player_t *p = ctx;
+
+    if(p->powerOn)
+    {
+        return;                     // Dozing between inputs, game still on
+    }
+    if(p->state != P_BOOT && p->state != P_ASLEEP)
+    {
+        player_finish(p, now);
+    }
+
+    p->state = P_ASLEEP;
+    if(p->played < p->games)
+    {
+        player_schedule(p, now + player_ms(p, 200, 2000));
+    }
+}
+
+void player_attach(player_t *p)
+{
+    sim_hooks.input = player_input;
+    sim_hooks.output = player_output;
+    sim_hooks.sleep = player_sleep;
+    sim_hooks.ctx = p;
+}
+
+void player_report(player_t *p, FILE *out)
+{
+    fprintf(out, "games played:  %d\n", p->played);
+    fprintf(out, "wins:          %d\n", p->wins);
+    fprintf(out, "losses:        %d\n", p->losses);
+    fprintf(out, "timeouts:      %d\n", p->timeouts);
+    fprintf(out, "errors:        %d\n", p->errors);
+    fprintf(out, "mean rounds:   %.2f (best %d)\n",
+            p->played ? (double)p->rounds / p->played : 0.0, p->bestRound);
+    fprintf(out, "mean game:     %.1f s\n",
+            p->played ? p->gameSeconds / p->played : 0.0);
+    fprintf(out, "reaction:      %.1f/%.1f/%.1f ms (%lld presses)\n",
+            p->reactions ? p->reactionMin : 0.0,
+            p->reactions ? p->reactionSum / p->reactions : 0.0,
+            p->reactionMax, p->reactions);
+    fprintf(out, "response:      LED on %.1f/%.1f/%.1f ms after the press (%lld presses)\n",
+            p->responses ? p->responseMin : 0.0,
+            p->responses ? p->responseSum / p->responses : 0.0,
+            p->responseMax, p->responses);
+    fprintf(out, "wake-up:       power LED on %.1f/%.1f us after the press (%d wake-ups)\n",
+            p->wakes ? p->wakeSum / p->wakes : 0.0, p->wakeMax, p->wakes);
+}
@@ -0,0 +1,116 @@
+/*==============================================================================
+ File: sim/simon-player.h
+ Date: October 16, 2026
+
+ Scripted Simon player for the UBMP4.2 host simulator
+
+ The player is connected to the simulated board through sim_hooks. It wakes
+ the board with a button press, records each pattern step from the LED that
+ lights while the pattern plays, and repeats the pattern on the buttons once
+ the board has been quiet for longer than the gap between pattern steps.
+ Results are decided from what the player saw and did, not from firmware
+ variables, so the player keeps working when the game code is refactored.
+
+ Like an eye, the player sees a dimmed (PWM) LED as steadily lit: an LED
+ that turns off is only seen off once LED_PERSIST has passed since its
+ output last turned on.
+
+ The player also times its own guesses the way the firmware's statistics
+ do - from when the step became available (the stepGap after the pattern
+ ends, or the end of the previous guess) to the press - so a test can check
+ the firmware's reaction times against the real ones. It times how long
+ each guess takes to light its LED after the press, and how long the power
+ LED takes to light after the press that wakes the board.
+==============================================================================*/
+
+#ifndef SIMON_PLAYER_H
+#define SIMON_PLAYER_H
+
+#include    <stdio.h>
+#include    <stdint.h>
+#include    <stdbool.h>
+
+#define PLAYER_MAX_STEPS    1024    // Longest pattern the player remembers
+
+// Game results
+#define RESULT_NONE     0           // Game still in progress
+#define RESULT_WIN      1           // Game played the win sequence
+#define RESULT_LOSE     2           // Player pressed a wrong button
+#define RESULT_TIMEOUT  3           // Player stopped and the game shut down
+#define RESULT_ERROR    4           // Game ended without a reason
+
+typedef struct
+{
+    // Configuration (set after player_init())
+    int games;                      // Games to play before leaving board asleep
+    int failRound;                  // Round to press a wrong button in (0 = never)
+    int idleRound;                  // Round to stop pressing in (0 = never)
+    int randomFail;                 // Pick a random fail round each game
+    int skipLose;                   // Press to skip the lose sequence
+    int verbose;                    // Print one line per game
+    uint32_t rng;                   // Player timing random state
+
+    // Current game
+    int state;                      // Player state
+    uint8_t seen[PLAYER_MAX_STEPS]; // Pattern steps seen in this turn
+    int seenCount;
+    int replay;                     // Next step to press
+    int round;                      // Rounds completed in this game
+    int gameFail;                   // Fail round for this game
+    int result;
+    uint8_t leds;                   // LED2-LED5 seen lit (bit 0 = LED2)
+    uint8_t rawLeds;                // LED2-LED5 outputs right now
+    uint64_t litTime[4];            // Time each LED output was last on
+    uint64_t due;                   // Next player_step() time
+    int powerOn;                    // Power LED (LED1) on: game running
+    uint64_t lastOff;               // Time the LEDs last all turned off
+    uint64_t gameStart;             // Time of the wake-up press
+    uint64_t ready;                 // Time the next guess became available
+    bool waking;                    // Wake-up press made, power LED still off
+    uint64_t guessTime;             // Time of the last guess press
+    bool guessing;                  // Guess pressed, its LED not lit yet
+
+    // Totals
+    int played;
+    int wins;
+    int losses;
+    int timeouts;
+    int errors;
+    long long rounds;               // Total rounds completed in all games
+    int bestRound;
+    double gameSeconds;             // Total virtual time from wake to sleep
+    long long reactions;            // Guess presses made
+    double reactionSum;             // Total, fastest and slowest time from
+    double reactionMin;             // each guess becoming available to its
+    double reactionMax;             // press (ms)
+    int wakes;                      // Wake-up presses that lit the power LED
+    double wakeSum;                 // Total and longest time from a wake-up
+    double wakeMax;                 // press to the power LED lighting (us)
+    long long responses;            // Guess presses answered by their LED
+    double responseSum;             // Total, fastest and slowest time from
+    double responseMin;             // each guess press to the LED lighting
+    double responseMax;             // (ms)
+} player_t;
+
+/**
+ * Function: void player_init(player_t *p, int games, uint32_t seed)
+ *
+ * Set up a perfect player that plays the requested number of games.
+ */
+void player_init(player_t *, int, uint32_t);
+
+/**
+ * Function: void player_attach(player_t *p)
+ *
+ * Connect the player to the simulated board hooks. Call after sim_reset().
+ */
+void player_attach(player_t *);
+
+/**
+ * Function: void player_report(player_t *p, FILE *out)
+ *
+ * Print the player's game totals.
+ */
+void player_report(player_t *, FILE *);
+
+#endif
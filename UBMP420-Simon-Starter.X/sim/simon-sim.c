@@ -0,0 +1,200 @@
+/*==============================================================================
+ File: sim/simon-sim.c
+ Date: October 16, 2026
+
+ Host simulation runner for UBMP4-Simon-Game
+
+ Boots the Simon game firmware on the simulated board and plays games against
+ it with a scripted player. The player only sees what a real player would:
+ it watches the LED outputs while the pattern plays, then presses the buttons
+ to repeat it. It can play perfectly, make a mistake in a chosen round, or
+ stop pressing to let the game time out.
+
+ The board is simulated event by event (every tick the game is awake for and
+ every tone half-period), at about 4000-5000x real time: 4-12 games/s on one
+ core, depending on how many rounds the games go. That is fast enough to
+ play a few games in make check and hundreds in a soak test, but not the
+ thousands of games per second a pure state machine model would run.
+
+ Built as simon-fast, it runs a firmware build (SIM_FAST) whose tones play
+ in batches of half-periods, one Timer1 interrupt per 16-bit period instead
+ of one per half-period. That removes nearly two thirds of the events, for
+ about 10000x real time: 11 games/s when every game goes all 42 rounds and
+ 24-29 games/s with -r, 2.1-2.7x faster. The games play out the same (same
+ rounds, presses and results), but the beeper no longer sounds its notes,
+ and as Timer1 is reloaded once per batch instead of once per half-period,
+ some tones end one tick later. The 1 ms ticks the game is awake for are
+ still simulated one by one and are now most of the cost, so this is still
+ nowhere near thousands of games/s.
+
+ Usage: simon-sim [-g games] [-f round] [-i round] [-k] [-l light] [-r] [-s seed] [-v]
+   -g games  number of games to play (default 100)
+   -f round  press a wrong button in this round (default: never)
+   -i round  stop pressing in this round so the game times out
+   -k        after losing, press a button to skip to a new game
+   -l light  ambient light level at Q1, 0-1023 (default 1023, full LED
+             brightness; lower levels dim the LEDs with PWM)
+   -r        make a mistake in a random round from 1 to 42
+   -s seed   player timing seed
+   -v        print one line per game
+==============================================================================*/
+
+#include    <stdio.h>
+#include    <stdlib.h>
+#include    <time.h>
+
+#include    "sim.h"
+#include    "simon-player.h"
+#include    "../UBMP420-stats.h"
+#include    "../UBMP420-buttons.h"
+
+extern int simon_main(void);        // Renamed firmware main()
+
+// The firmware times a press when it has been debounced, BUTTON_DEBOUNCE
+// scans after the switch closes, and rounds both ends to its 1 ms tick. A
+// press that wakes it from a doze is scanned at once, but the next scans
+// wait for ticks from Timer2, which runs 3x slower while the PLL locks.
+// Its reaction times must be the player's real press delays plus that, never
+// less (time lost while dozing would make them shorter).
+#define REACTION_SLACK  (BUTTON_DEBOUNCE + 4 + sim_pll_lock / SIM_CYCLES_PER_MS)
+
+// A guess must light its LED less than 5 ms after the press, including the
+// press that wakes the game from a doze: the PLL locks while it is debounced.
+#define RESPONSE_MAX    5               // ms
+
+// The power LED must light as soon as HFINTOSC has started after the IOC
+// edge, without waiting for the PLL to lock. nap() times its own part, from
+// waking to the LED write, with Timer1 at 250 ns per count.
+#define WAKE_SLACK      0.25            // us
+
+// Check the firmware's reaction statistics against the player's presses.
+// The firmware halves its press count and total when the count would pass
+// 0xFFFF, so after that its count drops back by 0x8000 each time and its
+// mean favours the later presses (only the count and the range are checked).
+static bool reactions_match(const stats_t *stats, const player_t *p)
+{
+    double mean;
+    long long count;
+
+    if(p->reactions == 0)
+    {
+        return(stats->reactions == 0);
+    }
+    mean = p->reactionSum / p->reactions;
+    count = p->reactions;
+    while(count > 0xFFFF)
+    {
+        count -= 0x8000;
+    }
+    return(stats->reactions == count &&
+           stats->reactionMin >= p->reactionMin &&
+           stats->reactionMin <= p->reactionMin + REACTION_SLACK &&
+           (count != p->reactions ||
+            (stats_reaction_mean() >= mean - 1 &&
+             stats_reaction_mean() <= mean + REACTION_SLACK)) &&
+           stats->reactionMax >= p->reactionMax &&
+           stats->reactionMax <= p->reactionMax + REACTION_SLACK);
+}
+
+int main(int argc, char **argv)
+{
+    player_t player;
+    const stats_t *stats;
+    int games = 100;
+    int failRound = 0;
+    int idleRound = 0;
+    int randomFail = 0;
+    int skipLose = 0;
+    int light = 1023;
+    unsigned int seed = 1;
+    int verbose = 0;
+    int i;
+    int halt;
+    struct timespec t0, t1;
+    double wall;
+    double lockUs = (double)sim_pll_lock / SIM_CYCLES_PER_US;
+    double oscUs = (double)sim_osc_wake / SIM_CYCLES_PER_US;
+
+    for(i = 1; i < argc; i++)
+    {
+        if(argv[i][0] == '-' && argv[i][1] == 'g' && i + 1 < argc)
+            games = atoi(argv[++i]);
+        else if(argv[i][0] == '-' && argv[i][1] == 'f' && i + 1 < argc)
+            failRound = atoi(argv[++i]);
+        else if(argv[i][0] == '-' && argv[i][1] == 'i' && i + 1 < argc)
+            idleRound = atoi(argv[++i]);
+        else if(argv[i][0] == '-' && argv[i][1] == 'k')
+            skipLose = 1;
+        else if(argv[i][0] == '-' && argv[i][1] == 'l' && i + 1 < argc)
+            light = atoi(argv[++i]);
+        else if(argv[i][0] == '-' && argv[i][1] == 's' && i + 1 < argc)
+            seed = (unsigned int)strtoul(argv[++i], NULL, 0);
+        else if(argv[i][0] == '-' && argv[i][1] == 'r')
+            randomFail = 1;
+        else if(argv[i][0] == '-' && argv[i][1] == 'v')
+            verbose = 1;
+        else
+        {
+            fprintf(stderr, "usage: %s [-g games] [-f round] [-i round] [-k] [-l light] [-r] [-s seed] [-v]\n", argv[0]);
+            return(2);
+        }
+    }
+
+    player_init(&player, games, seed);
+    player.failRound = failRound;
+    player.idleRound = idleRound;
+    player.randomFail = randomFail;
+    player.skipLose = skipLose;
+    player.verbose = verbose;
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    sim_reset();
+    sim_analog[7] = (uint16_t)light;    // Q1 (AN7)
+    player_attach(&player);
+    halt = sim_run(simon_main);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    wall = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9;
+
+    player_report(&player, stdout);
+    stats = stats_read();
+    printf("fw stats:      %u games, best %u, reaction %u/%u/%u ms (%u presses)\n",
+           stats->games, stats->bestScore, stats->reactions ? stats->reactionMin : 0,
+           stats_reaction_mean(), stats->reactionMax, stats->reactions);
+    if(stats->games != (unsigned int)player.played ||
+       stats->bestScore != (unsigned int)player.bestRound)
+    {
+        fprintf(stderr, "firmware statistics don't match the player\n");
+        player.errors++;
+    }
+    if(!reactions_match(stats, &player))
+    {
+        fprintf(stderr, "firmware reaction times don't match the player's presses\n");
+        player.errors++;
+    }
+    if(player.responseMax >= RESPONSE_MAX)
+    {
+        fprintf(stderr, "guess LEDs took %d ms or longer to light\n", RESPONSE_MAX);
+        player.errors++;
+    }
+    printf("fw wake-up:    power LED on %u ns after waking (HFINTOSC start-up %.1f us)\n",
+           stats->wakeTime, oscUs);
+    if(player.wakes != 0 &&
+       (player.wakeMax >= lockUs || player.wakeSum < player.wakes * oscUs ||
+        stats->wakeTime / 1000.0 > player.wakeMax - oscUs + WAKE_SLACK))
+    {
+        fprintf(stderr, "power LED waited for the PLL, or the wake-up times don't add up\n");
+        player.errors++;
+    }
+    printf("virtual time:  %.1f s (%.1f s asleep)\n",
+           (double)sim_now / (SIM_CYCLES_PER_MS * 1000.0),
+           (double)sim_sleep_cycles / (SIM_CYCLES_PER_MS * 1000.0));
+    printf("wall time:     %.3f s (%.0f games/s, %.0fx real time)\n",
+           wall, player.played / wall, sim_now / (SIM_CYCLES_PER_MS * 1000.0) / wall);
+
+    if(halt != SIM_HALT_ASLEEP)
+    {
+        fprintf(stderr, "simulation halted early (reason %d)\n", halt);
+        return(1);
+    }
+    return(player.errors != 0);
+}
@@ -0,0 +1,266 @@
+/*==============================================================================
+ File: sim/simon-trace.c
+ Date: October 16, 2026
+
+ Golden trace recorder and compare tool for UBMP4-Simon-Game
+
+ Records every edge on BEEPER, D1 and LED2-LED5 while the scripted player
+ plays, and compares the capture with a stored golden trace (see trace.h).
+ This guards the timing unit tests can't see: the pitch and length of each
+ note, the start, win and lose effects, and how the LEDs and sound overlap.
+
+ The golden trace's first line holds the options it was recorded with, so a
+ compare plays exactly the same games again. The run is deterministic: a
+ blank chip, fixed player seed and full light, so an unchanged firmware
+ matches its golden trace to the cycle.
+
+ Usage: simon-trace [-g games] [-f round] [-i round] [-k] [-l light] [-r]
+                    [-s seed] [-o file]
+        simon-trace -c golden [-t us] [-p percent] [-d us] [-o file] [capture]
+   -o file     write the capture here (default: standard output when
+               recording, nowhere when comparing)
+   -c golden   compare with this golden trace, playing the games it was
+               recorded with, or with the capture file given
+   -t us       interval error allowed on every edge (default 1 us)
+   -p percent  ...or this percentage of the golden interval (default 0.5)
+   -d us       drift allowed from the golden edge time (default 1000 us)
+   Other options are as for simon-sim (default: one game).
+==============================================================================*/
+
+#include    <stdio.h>
+#include    <stdlib.h>
+#include    <string.h>
+
+#include    "sim.h"
+#include    "simon-player.h"
+#include    "trace.h"
+
+extern int simon_main(void);        // Renamed firmware main()
+
+#define MAX_ARGS    32              // Most options read from a golden header
+
+// Player options of a recorded run
+typedef struct
+{
+    int games;
+    int failRound;
+    int idleRound;
+    int randomFail;
+    int skipLose;
+    int light;
+    unsigned int seed;
+} run_t;
+
+// Read the run option at argv[i]. Returns the index of its last word, or -1
+// if it isn't a run option.
+static int run_option(run_t *r, int argc, char **argv, int i)
+{
+    if(argv[i][0] != '-')
+        return(-1);
+    if(argv[i][1] == 'g' && i + 1 < argc)
+        r->games = atoi(argv[++i]);
+    else if(argv[i][1] == 'f' && i + 1 < argc)
+        r->failRound = atoi(argv[++i]);
+    else if(argv[i][1] == 'i' && i + 1 < argc)
+        r->idleRound = atoi(argv[++i]);
+    else if(argv[i][1] == 'k')
+        r->skipLose = 1;
+    else if(argv[i][1] == 'l' && i + 1 < argc)
+        r->light = atoi(argv[++i]);
+    else if(argv[i][1] == 's' && i + 1 < argc)
+        r->seed = (unsigned int)strtoul(argv[++i], NULL, 0);
+    else if(argv[i][1] == 'r')
+        r->randomFail = 1;
+    else
+        return(-1);
+    return(i);
+}
+
+// Read the run options from a trace header ("simon-trace -g 1 ...").
+static int run_header(run_t *r, const char *header)
+{
+    char words[TRACE_HEADER];
+    char *argv[MAX_ARGS];
+    int argc = 0;
+    int i;
+
+    strcpy(words, header);
+    for(argv[argc] = strtok(words, " "); argv[argc] != NULL && argc + 1 < MAX_ARGS;
+        argv[++argc] = strtok(NULL, " "))
+        ;
+    if(argc == 0 || strcmp(argv[0], "simon-trace") != 0)
+        return(-1);
+    for(i = 1; i < argc; i++)
+    {
+        i = run_option(r, argc, argv, i);
+        if(i < 0)
+            return(-1);
+    }
+    return(0);
+}
+
+// Play the run and record it into t. Returns the sim_run() halt reason.
+static int run_record(const run_t *r, trace_t *t)
+{
+    player_t player;
+    int halt;
+    int n;
+
+    player_init(&player, r->games, r->seed);
+    player.failRound = r->failRound;
+    player.idleRound = r->idleRound;
+    player.randomFail = r->randomFail;
+    player.skipLose = r->skipLose;
+
+    n = snprintf(t->header, TRACE_HEADER, "simon-trace -g %d -s %u -l %d",
+                 r->games, r->seed, r->light);
+    if(r->failRound)
+        n += snprintf(t->header + n, TRACE_HEADER - n, " -f %d", r->failRound);
+    if(r->idleRound)
+        n += snprintf(t->header + n, TRACE_HEADER - n, " -i %d", r->idleRound);
+    if(r->randomFail)
+        n += snprintf(t->header + n, TRACE_HEADER - n, " -r");
+    if(r->skipLose)
+        snprintf(t->header + n, TRACE_HEADER - n, " -k");
+
+    sim_flash_blank();
+    sim_reset();
+    sim_analog[7] = (uint16_t)r->light; // Q1 (AN7)
+    player_attach(&player);
+    trace_attach(t);
+    halt = sim_run(simon_main);
+
+    fprintf(stderr, "%s: %d games, %d wins, %d losses, %d timeouts, %d errors, %.1f s\n",
+            t->header, player.played, player.wins, player.losses, player.timeouts,
+            player.errors, (double)sim_now / (SIM_CYCLES_PER_MS * 1000.0));
+    if(player.errors != 0 && halt == SIM_HALT_ASLEEP)
+        halt = SIM_HALT_NONE;
+    return(halt);
+}
+
+static int load(trace_t *t, const char *path)
+{
+    FILE *in = fopen(path, "r");
+    int line;
+
+    if(in == NULL)
+    {
+        perror(path);
+        return(-1);
+    }
+    trace_init(t);
+    line = trace_read(t, in);
+    fclose(in);
+    if(line != 0)
+    {
+        fprintf(stderr, "%s:%d: bad trace line\n", path, line);
+        return(-1);
+    }
+    return(0);
+}
+
+static int save(const trace_t *t, const char *path)
+{
+    FILE *out = path ? fopen(path, "w") : stdout;
+
+    if(out == NULL || trace_write(t, out) != 0 || (path && fclose(out) != 0))
+    {
+        perror(path ? path : "stdout");
+        return(-1);
+    }
+    return(0);
+}
+
+int main(int argc, char **argv)
+{
+    run_t run = {1, 0, 0, 0, 0, 1023, 1};
+    trace_limits_t limits = {1.0, 0.5, 1000.0, 5};
+    trace_t golden, capture;
+    const char *goldenPath = NULL;
+    const char *capturePath = NULL;
+    const char *outPath = NULL;
+    int runOptions = 0;
+    int halt = SIM_HALT_ASLEEP;
+    long bad;
+    int i, next;
+
+    for(i = 1; i < argc; i++)
+    {
+        if((next = run_option(&run, argc, argv, i)) >= 0)
+        {
+            i = next;
+            runOptions = 1;
+        }
+        else if(argv[i][0] == '-' && argv[i][1] == 'o' && i + 1 < argc)
+            outPath = argv[++i];
+        else if(argv[i][0] == '-' && argv[i][1] == 'c' && i + 1 < argc)
+            goldenPath = argv[++i];
+        else if(argv[i][0] == '-' && argv[i][1] == 't' && i + 1 < argc)
+            limits.periodUs = atof(argv[++i]);
+        else if(argv[i][0] == '-' && argv[i][1] == 'p' && i + 1 < argc)
+            limits.periodPercent = atof(argv[++i]);
+        else if(argv[i][0] == '-' && argv[i][1] == 'd' && i + 1 < argc)
+            limits.driftUs = atof(argv[++i]);
+        else if(argv[i][0] != '-' && capturePath == NULL)
+            capturePath = argv[i];
+        else
+            break;
+    }
+    if(i != argc || (goldenPath == NULL && capturePath != NULL) ||
+       (goldenPath != NULL && runOptions))
+    {
+        fprintf(stderr, "usage: %s [-g games] [-f round] [-i round] [-k] [-l light] [-r] [-s seed] [-o file]\n"
+                        "       %s -c golden [-t us] [-p percent] [-d us] [-o file] [capture]\n",
+                argv[0], argv[0]);
+        return(2);
+    }
+
+    // Record only
+    trace_init(&capture);
+    if(goldenPath == NULL)
+    {
+        halt = run_record(&run, &capture);
+        if(save(&capture, outPath) != 0)
+            return(2);
+        if(halt != SIM_HALT_ASLEEP)
+        {
+            fprintf(stderr, "simulation halted early or the player saw errors (reason %d)\n", halt);
+            return(1);
+        }
+        return(0);
+    }
+
+    // Compare with a golden trace
+    if(load(&golden, goldenPath) != 0)
+        return(2);
+    if(capturePath != NULL)
+    {
+        if(load(&capture, capturePath) != 0)
+            return(2);
+    }
+    else
+    {
+        if(run_header(&run, golden.header) != 0)
+        {
+            fprintf(stderr, "%s: no simon-trace options on the first line\n", goldenPath);
+            return(2);
+        }
+        halt = run_record(&run, &capture);
+        if(outPath != NULL && save(&capture, outPath) != 0)
+            return(2);
+    }
+
+    printf("golden:        %s (%s)\n", goldenPath, golden.header);
+    printf("tolerance:     %.2f us or %.2f%% per interval, %.1f us drift\n",
+           limits.periodUs, limits.periodPercent, limits.driftUs);
+    bad = trace_compare(&golden, &capture, &limits, stdout);
+    if(capturePath == NULL && halt != SIM_HALT_ASLEEP)
+    {
+        fprintf(stderr, "simulation halted early or the player saw errors (reason %d)\n", halt);
+        bad++;
+    }
+    printf("result:        %s (%ld mismatched edges)\n", bad ? "FAIL" : "pass", bad);
+    trace_free(&golden);
+    trace_free(&capture);
+    return(bad != 0);
+}
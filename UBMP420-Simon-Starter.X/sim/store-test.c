@@ -0,0 +1,303 @@
+/*==============================================================================
+ File: sim/store-test.c
+ Date: October 16, 2026
+
+ HEF record store test for UBMP420-store
+
+ Runs the firmware's record store on the simulated flash through many
+ simulated power-ups ("boots"), each of which loads the newest record and
+ saves a number of new ones, and checks that every boot finds the last
+ record saved:
+
+   wear    saves thousands of records and checks that the erases are spread
+           evenly over the four HEF rows and no other row is touched
+   power   cuts the power during each flash operation of a save, at every
+           position in the log, then checks that the next boot finds either
+           the record being saved or the one before it, and that saving
+           carries on normally afterwards
+   worn    makes the rows wear out after a few erases, and checks that worn
+           rows are skipped and a record is never lost or corrupted
+   score   saves the game's stats record with a best score above 255, and
+           checks that the next boot restores it and the games played
+
+ Usage: store-test [-n saves] [-v]
+   -n saves  records saved in the wear test (default 4000)
+   -v        print the HEF row erase counts
+==============================================================================*/
+
+#include    <stdio.h>
+#include    <stdlib.h>
+
+#include    "sim.h"
+#include    "../UBMP420-store.h"
+#include    "../UBMP420-stats.h"
+
+#define HEF_ROW     (STORE_START / SIM_FLASH_ROW)   // First HEF row
+
+// Firmware record store
+extern bool store_init(unsigned char *);
+extern void store_write(const unsigned char *);
+extern bool store_pending(void);
+extern void store_flush(void);
+
+// Firmware stats record
+extern void load_stats(void);
+extern void end_game(uint16_t);
+
+// Work for the next boot, and what it found
+static int bootSaves;               // Records to save
+static bool bootFound;              // A record was found
+static unsigned int bootValue;      // Value of the record found
+static bool bootBad;                // The record found was corrupt
+static unsigned int value;          // Value of the last record saved
+static unsigned int unsaved;        // Saves left pending (worn-out store)
+
+static unsigned int bootScore;      // Score of the game to save (0 = none)
+
+static int failures = 0;
+static int verbose = 0;
+
+// Record data for a value. The extra bytes check the record's integrity.
+static void make_data(unsigned int v, unsigned char *data)
+{
+    data[0] = (unsigned char)v;
+    data[1] = (unsigned char)(v >> 8);
+    data[2] = (unsigned char)(v * 7);
+    data[3] = (unsigned char)~v;
+    data[4] = 0x5A;
+}
+
+// One power-up: load the newest record, then save bootSaves new ones.
+static int boot_main(void)
+{
+    unsigned char data[STORE_DATA];
+    unsigned char check[STORE_DATA];
+    int i;
+
+    bootFound = store_init(data);
+    if(bootFound)
+    {
+        bootValue = data[0] | (data[1] << 8);
+        make_data(bootValue, check);
+        bootBad = false;
+        for(i = 0; i != STORE_DATA; i++)
+        {
+            bootBad |= data[i] != check[i];
+        }
+    }
+    for(i = 0; i != bootSaves; i++)
+    {
+        make_data(value + 1, data);
+        store_write(data);
+        store_flush();
+        if(store_pending())
+        {
+            unsaved++;
+        }
+        else
+        {
+            value++;
+        }
+    }
+    return(0);
+}
+
+// Boot the simulated board. Returns the halt reason.
+static int boot(int saves)
+{
+    bootSaves = saves;
+    sim_reset();
+    return(sim_run(boot_main));
+}
+
+static void fail(const char *test, const char *what, unsigned int detail)
+{
+    fprintf(stderr, "%s: %s (%u)\n", test, what, detail);
+    failures++;
+}
+
+// Check that a boot found the record of value (or none if value is 0).
+static void expect(const char *test, unsigned int v)
+{
+    if(bootFound && bootBad)
+    {
+        fail(test, "corrupt record loaded", bootValue);
+    }
+    else if(v == 0 ? bootFound : !bootFound || bootValue != v)
+    {
+        fail(test, "wrong record loaded", bootFound ? bootValue : 0);
+    }
+}
+
+static void test_wear(int saves)
+{
+    uint32_t lo = UINT32_MAX;
+    uint32_t hi = 0;
+    uint32_t others = 0;
+    int row;
+
+    sim_flash_blank();
+    value = 0;
+    while(saves > 0)
+    {
+        boot(saves < 10 ? saves : 10);
+        saves -= 10;
+        boot(0);
+        expect("wear", value);
+    }
+    for(row = 0; row != SIM_FLASH_ROWS; row++)
+    {
+        if(row >= HEF_ROW && row < HEF_ROW + STORE_ROWS)
+        {
+            lo = sim_flash_erases[row] < lo ? sim_flash_erases[row] : lo;
+            hi = sim_flash_erases[row] > hi ? sim_flash_erases[row] : hi;
+            if(verbose)
+            {
+                printf("  row 0x%04X erased %u times\n", row * SIM_FLASH_ROW,
+                       sim_flash_erases[row]);
+            }
+        }
+        else
+        {
+            others += sim_flash_erases[row];
+        }
+    }
+    printf("wear:   %u saves, HEF rows erased %u-%u times (%.1f saves per erase)\n",
+           value, lo, hi, (double)value / (lo + hi) * 2);
+    if(hi - lo > 1)
+    {
+        fail("wear", "uneven row erases", hi - lo);
+    }
+    if(others != 0)
+    {
+        fail("wear", "erases outside HEF", others);
+    }
+}
+
+static void test_power(void)
+{
+    int start;
+    int op;
+    int cases = 0;
+    int torn = 0;
+
+    for(start = 0; start != 2 * STORE_SLOTS; start++)
+    {
+        for(op = 1; op <= 3; op++)  // Cut during the 1st to 3rd flash operation
+        {
+            sim_flash_blank();
+            value = 0;
+            boot(STORE_SLOTS + start);  // Fill the log, ending anywhere
+            sim_flash_fail = (uint32_t)op;
+            if(boot(3) != SIM_HALT_POWER)  // 3 saves: 3 to 4 operations
+            {
+                fail("power", "power cut missed", (unsigned int)op);
+                sim_flash_fail = 0;
+                continue;
+            }
+            cases++;
+            boot(0);                // Last record or the one being saved
+            if(bootFound && !bootBad && bootValue == value + 1)
+            {
+                value++;
+            }
+            else
+            {
+                torn++;
+            }
+            expect("power", value);
+            boot(STORE_SLOTS + 1);  // Saving carries on
+            boot(0);
+            expect("power", value);
+        }
+    }
+    printf("power:  %d power cuts, %d torn saves dropped, no older records lost\n",
+           cases, torn);
+}
+
+// One power-up of the game: restore the saved stats, like main(), then end
+// a game with bootScore and save it.
+static int score_main(void)
+{
+    stats_restore(0, 0);        // RAM is lost at power-down
+    load_stats();
+    if(bootScore != 0)
+    {
+        stats_game_start();
+        end_game(bootScore);
+        store_flush();
+    }
+    return(0);
+}
+
+static void test_score(void)
+{
+    const stats_t *stats = stats_read();
+
+    sim_flash_blank();
+    bootScore = 300;            // Too big for one byte
+    sim_reset();
+    sim_run(score_main);
+    bootScore = 0;
+    sim_reset();
+    sim_run(score_main);
+    printf("score:  saved best score 300, restored %u (%u games)\n",
+           stats->bestScore, stats->games);
+    if(stats->bestScore != 300 || stats->games != 1)
+    {
+        fail("score", "stats not restored", stats->bestScore);
+    }
+}
+
+static void test_worn(void)
+{
+    int boots;
+
+    sim_flash_blank();
+    sim_flash_endurance = 4;
+    value = 0;
+    unsaved = 0;
+    for(boots = 0; boots != 100; boots++)
+    {
+        boot(4);
+        boot(0);
+        expect("worn", value);
+    }
+    sim_flash_endurance = 0;
+    printf("worn:   %u saves before the HEF wore out (4 erases per row), %u refused\n",
+           value, unsaved);
+    if(value < STORE_ROWS * 4 * (STORE_SLOTS / STORE_ROWS) || unsaved == 0)
+    {
+        fail("worn", "unexpected wear-out", value);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    int saves = 4000;
+    int i;
+
+    for(i = 1; i < argc; i++)
+    {
+        if(argv[i][0] == '-' && argv[i][1] == 'n' && i + 1 < argc)
+            saves = atoi(argv[++i]);
+        else if(argv[i][0] == '-' && argv[i][1] == 'v')
+            verbose = 1;
+        else
+        {
+            fprintf(stderr, "usage: %s [-n saves] [-v]\n", argv[0]);
+            return(2);
+        }
+    }
+
+    test_wear(saves);
+    test_power();
+    test_worn();
+    test_score();
+    if(failures != 0)
+    {
+        fprintf(stderr, "%d store test failure(s)\n", failures);
+        return(1);
+    }
+    return(0);
+}
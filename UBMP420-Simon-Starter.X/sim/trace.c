@@ -0,0 +1,335 @@
+/*==============================================================================
+ File: sim/trace.c
+ Date: October 16, 2026
+
+ Output pin trace recorder and golden trace compare functions
+
+ The recorder sits in front of the player's output() hook. Each pin keeps
+ the run its next edge can extend: a run is extended while the edges keep
+ coming at its period, and when a two-edge run is broken, its second edge
+ moves to the new run instead - so the silence before a tone and the tone's
+ first half-period don't end up in the same run, and each tone is one line.
+==============================================================================*/
+
+#include    <stdlib.h>
+#include    <string.h>
+
+#include    "trace.h"
+
+#define CYCLES_PER_MS   ((double)SIM_CYCLES_PER_MS)
+
+const char *trace_pin_name[TRACE_PINS] =
+{
+    "BEEPER", "D1", "LED2", "LED3", "LED4", "LED5"
+};
+
+static trace_t *recording;          // Trace attached to the output() hook
+
+void trace_init(trace_t *t)
+{
+    int pin;
+
+    *t = (trace_t){0};
+    for(pin = 0; pin != TRACE_PINS; pin++)
+    {
+        t->open[pin] = -1;
+    }
+}
+
+void trace_free(trace_t *t)
+{
+    free(t->runs);
+    t->runs = NULL;
+    t->count = 0;
+    t->size = 0;
+}
+
+// Add a run to the end of the trace and return its index.
+static long trace_add(trace_t *t, uint64_t start, int pin, uint8_t level)
+{
+    if(t->count == t->size)
+    {
+        t->size = t->size ? t->size * 2 : 1024;
+        t->runs = realloc(t->runs, t->size * sizeof(trace_run_t));
+        if(t->runs == NULL)
+        {
+            fprintf(stderr, "trace: out of memory\n");
+            exit(1);
+        }
+    }
+    t->runs[t->count] = (trace_run_t){start, 0, 1, (uint8_t)pin, level};
+    return((long)t->count++);
+}
+
+void trace_edge(trace_t *t, uint64_t now, int pin, uint8_t level)
+{
+    trace_run_t *run;
+    uint64_t last;
+
+    level = level ? 1 : 0;
+    if(((t->levels >> pin) & 1) == level)
+    {
+        return;                     // Not an edge
+    }
+    t->levels ^= (uint8_t)(1 << pin);
+
+    if(t->open[pin] >= 0)
+    {
+        run = &t->runs[t->open[pin]];
+        last = run->start + (uint64_t)(run->edges - 1) * run->period;
+        if(run->edges == 1 && now - last <= UINT32_MAX)
+        {
+            run->period = (uint32_t)(now - last);
+            run->edges = 2;
+            return;
+        }
+        if(now - last == run->period && run->edges != UINT32_MAX)
+        {
+            run->edges++;
+            return;
+        }
+        if(run->edges == 2 && now - last <= UINT32_MAX)
+        {
+            // Start again from the run's second edge
+            run->period = 0;
+            run->edges = 1;
+            t->open[pin] = trace_add(t, last, pin, level ^ 1);
+            run = &t->runs[t->open[pin]];
+            run->period = (uint32_t)(now - last);
+            run->edges = 2;
+            return;
+        }
+    }
+    t->open[pin] = trace_add(t, now, pin, level);
+}
+
+static void trace_output(void *ctx, uint64_t now, uint8_t lata, uint8_t latc)
+{
+    trace_t *t = recording;
+
+    trace_edge(t, now, 0, lata & 0x10);     // BEEPER (LATA4)
+    trace_edge(t, now, 1, lata & 0x20);     // D1 (LATA5)
+    trace_edge(t, now, 2, latc & 0x10);     // LED2-LED5 (LATC4-LATC7)
+    trace_edge(t, now, 3, latc & 0x20);
+    trace_edge(t, now, 4, latc & 0x40);
+    trace_edge(t, now, 5, latc & 0x80);
+    if(t->next)
+    {
+        t->next(ctx, now, lata, latc);
+    }
+}
+
+void trace_attach(trace_t *t)
+{
+    recording = t;
+    t->next = sim_hooks.output;
+    sim_hooks.output = trace_output;
+}
+
+// Order runs by first edge (runs moved by trace_edge() can be out of order).
+static int run_order(const void *a, const void *b)
+{
+    const trace_run_t *ra = a;
+    const trace_run_t *rb = b;
+
+    if(ra->start != rb->start)
+    {
+        return(ra->start < rb->start ? -1 : 1);
+    }
+    return((int)ra->pin - (int)rb->pin);
+}
+
+int trace_write(const trace_t *t, FILE *out)
+{
+    trace_run_t *runs = malloc((t->count + 1) * sizeof(trace_run_t));
+    size_t i;
+
+    if(runs == NULL)
+    {
+        return(-1);
+    }
+    memcpy(runs, t->runs, t->count * sizeof(trace_run_t));
+    qsort(runs, t->count, sizeof(trace_run_t), run_order);
+
+    fprintf(out, "# %s\n", t->header[0] ? t->header : "trace");
+    fprintf(out, "# cycle pin level [period edges]\n");
+    for(i = 0; i != t->count; i++)
+    {
+        fprintf(out, "%llu %s %u", (unsigned long long)runs[i].start,
+                trace_pin_name[runs[i].pin], runs[i].level);
+        if(runs[i].edges > 1)
+        {
+            fprintf(out, " %u %u", runs[i].period, runs[i].edges);
+        }
+        fputc('\n', out);
+    }
+    free(runs);
+    return(ferror(out) ? -1 : 0);
+}
+
+int trace_read(trace_t *t, FILE *in)
+{
+    char line[TRACE_HEADER + 2];
+    char name[16];
+    unsigned long long start;
+    unsigned int level, period, edges;
+    int number = 0;
+    int fields;
+    int pin;
+    long run;
+
+    while(fgets(line, sizeof(line), in) != NULL)
+    {
+        number++;
+        if(line[0] == '#')
+        {
+            if(number == 1 && line[1] == ' ')
+            {
+                snprintf(t->header, TRACE_HEADER, "%s", line + 2);
+                t->header[strcspn(t->header, "\r\n")] = '\0';
+            }
+            continue;
+        }
+        fields = sscanf(line, "%llu %15s %u %u %u", &start, name, &level, &period, &edges);
+        if(fields == EOF)
+        {
+            continue;               // Blank line
+        }
+        for(pin = 0; pin != TRACE_PINS && strcmp(name, trace_pin_name[pin]) != 0; pin++)
+            ;
+        if((fields != 3 && fields != 5) || pin == TRACE_PINS || level > 1 ||
+           (fields == 5 && edges == 0))
+        {
+            return(number);
+        }
+        run = trace_add(t, start, pin, (uint8_t)level);
+        if(fields == 5)
+        {
+            t->runs[run].period = period;
+            t->runs[run].edges = edges;
+        }
+    }
+    return(0);
+}
+
+// List the edges of one pin in time order (the runs of a pin are added in
+// order): times[] and levels[] are allocated. Returns the number of edges.
+static size_t pin_edges(const trace_t *t, int pin, uint64_t **times, uint8_t **levels)
+{
+    size_t count = 0;
+    size_t i, n;
+    uint32_t k;
+
+    for(i = 0; i != t->count; i++)
+    {
+        if(t->runs[i].pin == pin)
+        {
+            count += t->runs[i].edges;
+        }
+    }
+    *times = malloc((count + 1) * sizeof(uint64_t));
+    *levels = malloc(count + 1);
+    if(*times == NULL || *levels == NULL)
+    {
+        fprintf(stderr, "trace: out of memory\n");
+        exit(1);
+    }
+
+    n = 0;
+    for(i = 0; i != t->count; i++)
+    {
+        const trace_run_t *run = &t->runs[i];
+
+        if(run->pin != pin)
+        {
+            continue;
+        }
+        for(k = 0; k != run->edges; k++)
+        {
+            (*times)[n] = run->start + (uint64_t)k * run->period;
+            (*levels)[n] = run->level ^ (k & 1);
+            n++;
+        }
+    }
+    return(n);
+}
+
+long trace_compare(const trace_t *golden, const trace_t *capture,
+                   const trace_limits_t *limits, FILE *report)
+{
+    long total = 0;
+    int pin;
+
+    for(pin = 0; pin != TRACE_PINS; pin++)
+    {
+        uint64_t *gt, *ct;
+        uint8_t *gl, *cl;
+        size_t gn = pin_edges(golden, pin, &gt, &gl);
+        size_t cn = pin_edges(capture, pin, &ct, &cl);
+        size_t n = gn < cn ? gn : cn;
+        size_t i;
+        long bad = 0;
+        double worstPeriod = 0;
+        double worstDrift = 0;
+
+        for(i = 0; i != n; i++)
+        {
+            double drift = ((double)ct[i] - (double)gt[i]) / SIM_CYCLES_PER_US;
+            double gap = i ? ((double)gt[i] - (double)gt[i - 1]) / SIM_CYCLES_PER_US : 0;
+            double error = i ? ((double)ct[i] - (double)ct[i - 1]) / SIM_CYCLES_PER_US - gap : 0;
+            double allowed = gap * limits->periodPercent / 100;
+            const char *what = NULL;
+
+            if(allowed < limits->periodUs)
+            {
+                allowed = limits->periodUs;
+            }
+            if(error < 0 ? -error > worstPeriod : error > worstPeriod)
+            {
+                worstPeriod = error < 0 ? -error : error;
+            }
+            if(drift < 0 ? -drift > worstDrift : drift > worstDrift)
+            {
+                worstDrift = drift < 0 ? -drift : drift;
+            }
+
+            if(cl[i] != gl[i])
+            {
+                what = "level";
+            }
+            else if(error > allowed || error < -allowed)
+            {
+                what = "interval";
+            }
+            else if(drift > limits->driftUs || drift < -limits->driftUs)
+            {
+                what = "drift";
+            }
+            if(what == NULL)
+            {
+                continue;
+            }
+            if(bad++ < limits->reports)
+            {
+                fprintf(report, "  %s edge %zu to %u at %.3f ms: %s, interval %.1f us (golden %.1f us), drift %.1f us\n",
+                        trace_pin_name[pin], i, cl[i], ct[i] / CYCLES_PER_MS, what,
+                        gap + error, gap, drift);
+            }
+        }
+        if(gn != cn)
+        {
+            fprintf(report, "  %s has %zu edges, golden %zu: first %s edge at %.3f ms\n",
+                    trace_pin_name[pin], cn, gn, cn > gn ? "extra" : "missing",
+                    (cn > gn ? ct[n] : gt[n]) / CYCLES_PER_MS);
+            bad += (long)(cn > gn ? cn - gn : gn - cn);
+        }
+        fprintf(report, "%-8s %8zu edges, worst interval error %.2f us, worst drift %.2f us: %s\n",
+                trace_pin_name[pin], cn, worstPeriod, worstDrift, bad ? "MISMATCH" : "ok");
+        total += bad;
+        free(gt);
+        free(gl);
+        free(ct);
+        free(cl);
+    }
+    return(total);
+}
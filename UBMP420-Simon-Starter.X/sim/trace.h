@@ -0,0 +1,131 @@
+/*==============================================================================
+ File: sim/trace.h
+ Date: October 16, 2026
+
+ Output pin trace recorder and golden trace compare definitions
+
+ The recorder captures every edge on the pins a player hears and sees -
+ BEEPER (LATA4), D1 (LATA5) and LED2-LED5 (LATC4-LATC7) - with its virtual
+ time in instruction cycles. Edges that repeat at a fixed period on one pin,
+ like a tone on BEEPER, are kept as a single run (first edge, period and
+ number of edges), so a whole game fits in a small text file:
+
+    # simon-trace -g 1 -f 5
+    # cycle pin level [period edges]
+    10176 D1 0
+    13212144 BEEPER 1 9101 132
+
+ A run line stands for edges cycles apart, alternating in level from the one
+ given. Lines starting with # are comments; the first one holds the options
+ the trace was recorded with.
+
+ Traces are compared pin by pin, edge by edge. Each edge must have the same
+ level as in the golden trace, the time since the pin's previous edge (a
+ tone half-period, an LED on or off time) must be within a tolerance, and
+ the edge may not drift further than a set time from its golden time (so
+ the LEDs and sound still overlap as before).
+==============================================================================*/
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include    <stdio.h>
+#include    <stdint.h>
+#include    <stddef.h>
+
+#include    "sim.h"
+
+#define TRACE_PINS      6           // BEEPER, D1, LED2-LED5
+#define TRACE_HEADER    256         // Longest options line kept from a file
+
+// A run of edges on one pin
+typedef struct
+{
+    uint64_t start;                 // Time of the first edge (cycles)
+    uint32_t period;                // Cycles between edges (0 for one edge)
+    uint32_t edges;                 // Number of edges in the run
+    uint8_t pin;                    // Pin number (0 = BEEPER, see trace_pin_name)
+    uint8_t level;                  // Level after the first edge
+} trace_run_t;
+
+typedef struct
+{
+    trace_run_t *runs;              // Runs, each pin's in time order
+    size_t count;
+    size_t size;
+    long open[TRACE_PINS];          // Run each pin's next edge may extend (-1 = none)
+    uint8_t levels;                 // Pin levels now (bit n = pin n)
+    void (*next)(void *, uint64_t, uint8_t, uint8_t);   // Chained output() hook
+    char header[TRACE_HEADER];      // Options the trace was recorded with
+} trace_t;
+
+// Compare tolerances
+typedef struct
+{
+    double periodUs;                // Interval error allowed on every edge (us)
+    double periodPercent;           // ...or this percentage of the interval
+    double driftUs;                 // Edge time error allowed (us)
+    int reports;                    // Mismatches to print for each pin
+} trace_limits_t;
+
+extern const char *trace_pin_name[TRACE_PINS];
+
+/**
+ * Function: void trace_init(trace_t *t)
+ *
+ * Start an empty trace with all pins low.
+ */
+void trace_init(trace_t *);
+
+/**
+ * Function: void trace_free(trace_t *t)
+ *
+ * Free the memory of a trace.
+ */
+void trace_free(trace_t *);
+
+/**
+ * Function: void trace_attach(trace_t *t)
+ *
+ * Record the board's output edges into t. Call after sim_reset() and after
+ * attaching the player: the output() hook already set is still called on
+ * every output change. Only one trace can record at a time.
+ */
+void trace_attach(trace_t *);
+
+/**
+ * Function: void trace_edge(trace_t *t, uint64_t now, int pin, uint8_t level)
+ *
+ * Add one edge to the trace. Used by the recorder, and to build traces by
+ * hand.
+ */
+void trace_edge(trace_t *, uint64_t, int, uint8_t);
+
+/**
+ * Function: int trace_write(const trace_t *t, FILE *out)
+ *
+ * Write the trace as text, starting with its header. Returns 0, or -1 on a
+ * write error.
+ */
+int trace_write(const trace_t *, FILE *);
+
+/**
+ * Function: int trace_read(trace_t *t, FILE *in)
+ *
+ * Read a trace written by trace_write() into t (after trace_init()). The
+ * text after "# " on the first line is kept in t->header. Returns 0, or the
+ * number of the first bad line.
+ */
+int trace_read(trace_t *, FILE *);
+
+/**
+ * Function: long trace_compare(const trace_t *golden, const trace_t *capture,
+ *                              const trace_limits_t *limits, FILE *report)
+ *
+ * Compare a captured trace with a golden one within the limits, printing a
+ * summary line for each pin and the first mismatches to report. Returns the
+ * number of mismatched edges (0 if the traces match).
+ */
+long trace_compare(const trace_t *, const trace_t *, const trace_limits_t *, FILE *);
+
+#endif
@@ -0,0 +1,244 @@
+/*==============================================================================
+ File: sim/xc.h
+ Date: October 16, 2026
+
+ Host simulation replacement for the Microchip XC8 xc.h include file
+
+ The firmware sources include "xc.h" to reach the PIC16F1459 special function
+ registers (SFRs). Host builds put this directory on the include path so the
+ same sources compile with the native C compiler against a register model
+ instead: every SFR lives in sim_sfr[] at its real PIC16F1459 data memory
+ address, and the bit names used by the firmware (LATAbits.LATA4, TMR1IF, GO,
+ etc.) map onto the same bytes. The simulator in sim.c watches those registers
+ and runs the oscillator, timers, IOC, ADC and sleep logic on a virtual clock.
+
+ Only the registers and bits used by the UBMP4 firmware are defined here.
+
+ The host's int is 32 bits, not XC8's 16, so the firmware uses uint16_t and
+ uint32_t for its variables and the Makefile refuses to build firmware that
+ declares an int, short or long.
+==============================================================================*/
+
+#ifndef SIM_XC_H
+#define SIM_XC_H
+
+#include    <stdint.h>
+#include    <stdbool.h>
+
+#include    "sim.h"             // Simulator clock, sleep and interrupt model
+
+// Register model. Indexed by linear PIC16F1459 data memory address.
+extern volatile uint8_t sim_sfr[SIM_SFR_SIZE];
+
+#define SIM_REG(addr)           (sim_sfr[(addr)])
+#define SIM_BITS(type, addr)    (*(volatile type *)&sim_sfr[(addr)])
+#define SIM_REG16(addr)         (((volatile sim_reg16_t *)&sim_sfr[(addr)])->value)
+
+// 16-bit register pair (ADRES is at an odd address, so no alignment)
+typedef struct __attribute__((packed))
+{
+    uint16_t value;
+} sim_reg16_t;
+
+// Bank 0 registers
+#define STATUS      SIM_REG(SFR_STATUS)
+#define INTCON      SIM_REG(SFR_INTCON)
+#define PORTA       SIM_REG(SFR_PORTA)
+#define PORTB       SIM_REG(SFR_PORTB)
+#define PORTC       SIM_REG(SFR_PORTC)
+#define PIR1        SIM_REG(SFR_PIR1)
+#define PIR2        SIM_REG(SFR_PIR2)
+#define TMR0        SIM_REG(SFR_TMR0)
+#define TMR1L       SIM_REG(SFR_TMR1L)
+#define TMR1H       SIM_REG(SFR_TMR1H)
+#define TMR1        SIM_REG16(SFR_TMR1L)
+#define T1CON       SIM_REG(SFR_T1CON)
+#define T1GCON      SIM_REG(SFR_T1GCON)
+#define TMR2        SIM_REG(SFR_TMR2)
+#define PR2         SIM_REG(SFR_PR2)
+#define T2CON       SIM_REG(SFR_T2CON)
+
+// Bank 1 registers
+#define TRISA       SIM_REG(SFR_TRISA)
+#define TRISB       SIM_REG(SFR_TRISB)
+#define TRISC       SIM_REG(SFR_TRISC)
+#define PIE1        SIM_REG(SFR_PIE1)
+#define PIE2        SIM_REG(SFR_PIE2)
+#define OPTION_REG  SIM_REG(SFR_OPTION_REG)
+#define PCON        SIM_REG(SFR_PCON)
+#define WDTCON      SIM_REG(SFR_WDTCON)
+#define OSCTUNE     SIM_REG(SFR_OSCTUNE)
+#define OSCCON      SIM_REG(SFR_OSCCON)
+#define OSCSTAT     SIM_REG(SFR_OSCSTAT)
+#define ADRESL      SIM_REG(SFR_ADRESL)
+#define ADRESH      SIM_REG(SFR_ADRESH)
+#define ADRES       SIM_REG16(SFR_ADRESL)
+#define ADCON0      SIM_REG(SFR_ADCON0)
+#define ADCON1      SIM_REG(SFR_ADCON1)
+#define ADCON2      SIM_REG(SFR_ADCON2)
+
+// Bank 2 registers
+#define LATA        SIM_REG(SFR_LATA)
+#define LATB        SIM_REG(SFR_LATB)
+#define LATC        SIM_REG(SFR_LATC)
+#define FVRCON      SIM_REG(SFR_FVRCON)
+
+// Bank 3 registers
+#define ANSELA      SIM_REG(SFR_ANSELA)
+#define ANSELB      SIM_REG(SFR_ANSELB)
+#define ANSELC      SIM_REG(SFR_ANSELC)
+#define PMADRL      SIM_REG(SFR_PMADRL)
+#define PMADRH      SIM_REG(SFR_PMADRH)
+#define PMDATL      SIM_REG(SFR_PMDATL)
+#define PMDATH      SIM_REG(SFR_PMDATH)
+#define PMCON1      SIM_REG(SFR_PMCON1)
+#define PMCON2      SIM_REG(SFR_PMCON2)
+
+// Bank 4 and bank 7 registers
+#define WPUA        SIM_REG(SFR_WPUA)
+#define WPUB        SIM_REG(SFR_WPUB)
+#define IOCAP       SIM_REG(SFR_IOCAP)
+#define IOCAN       SIM_REG(SFR_IOCAN)
+#define IOCAF       SIM_REG(SFR_IOCAF)
+#define IOCBP       SIM_REG(SFR_IOCBP)
+#define IOCBN       SIM_REG(SFR_IOCBN)
+#define IOCBF       SIM_REG(SFR_IOCBF)
+#define ACTCON      SIM_REG(SFR_ACTCON)
+
+// Register bit structures
+typedef struct
+{
+    uint8_t RA0:1, RA1:1, RA2:1, RA3:1, RA4:1, RA5:1, RA6:1, RA7:1;
+} PORTAbits_t;
+typedef struct
+{
+    uint8_t RB0:1, RB1:1, RB2:1, RB3:1, RB4:1, RB5:1, RB6:1, RB7:1;
+} PORTBbits_t;
+typedef struct
+{
+    uint8_t RC0:1, RC1:1, RC2:1, RC3:1, RC4:1, RC5:1, RC6:1, RC7:1;
+} PORTCbits_t;
+typedef struct
+{
+    uint8_t LATA0:1, LATA1:1, LATA2:1, LATA3:1, LATA4:1, LATA5:1, LATA6:1, LATA7:1;
+} LATAbits_t;
+typedef struct
+{
+    uint8_t LATB0:1, LATB1:1, LATB2:1, LATB3:1, LATB4:1, LATB5:1, LATB6:1, LATB7:1;
+} LATBbits_t;
+typedef struct
+{
+    uint8_t LATC0:1, LATC1:1, LATC2:1, LATC3:1, LATC4:1, LATC5:1, LATC6:1, LATC7:1;
+} LATCbits_t;
+typedef struct
+{
+    uint8_t TRISC0:1, TRISC1:1, TRISC2:1, TRISC3:1, TRISC4:1, TRISC5:1, TRISC6:1, TRISC7:1;
+} TRISCbits_t;
+typedef struct
+{
+    uint8_t C:1, DC:1, Z:1, nPD:1, nTO:1, :3;
+} STATUSbits_t;
+typedef struct
+{
+    uint8_t IOCIF:1, INTF:1, TMR0IF:1, IOCIE:1, INTE:1, TMR0IE:1, PEIE:1, GIE:1;
+} INTCONbits_t;
+typedef struct
+{
+    uint8_t TMR1IF:1, TMR2IF:1, :1, SSP1IF:1, TXIF:1, RCIF:1, ADIF:1, TMR1GIF:1;
+} PIR1bits_t;
+typedef struct
+{
+    uint8_t TMR1IE:1, TMR2IE:1, :1, SSP1IE:1, TXIE:1, RCIE:1, ADIE:1, TMR1GIE:1;
+} PIE1bits_t;
+typedef struct
+{
+    uint8_t TMR1ON:1, :1, nT1SYNC:1, T1OSCEN:1, T1CKPS:2, TMR1CS:2;
+} T1CONbits_t;
+typedef struct
+{
+    uint8_t T2CKPS:2, TMR2ON:1, T2OUTPS:4, :1;
+} T2CONbits_t;
+typedef struct
+{
+    uint8_t SWDTEN:1, WDTPS:5, :2;
+} WDTCONbits_t;
+typedef struct
+{
+    uint8_t HFIOFS:1, LFIOFR:1, :1, HFIOFR:1, :1, OSTS:1, PLLRDY:1, SOSCR:1;
+} OSCSTATbits_t;
+typedef struct
+{
+    uint8_t ADON:1, GO_nDONE:1, CHS:5, :1;
+} ADCON0bits_t;
+typedef struct
+{
+    uint8_t RD:1, WR:1, WREN:1, WRERR:1, FREE:1, LWLO:1, CFGS:1, :1;
+} PMCON1bits_t;
+
+#define PORTAbits   SIM_BITS(PORTAbits_t, SFR_PORTA)
+#define PORTBbits   SIM_BITS(PORTBbits_t, SFR_PORTB)
+#define PORTCbits   SIM_BITS(PORTCbits_t, SFR_PORTC)
+#define LATAbits    SIM_BITS(LATAbits_t, SFR_LATA)
+#define LATBbits    SIM_BITS(LATBbits_t, SFR_LATB)
+#define LATCbits    SIM_BITS(LATCbits_t, SFR_LATC)
+#define TRISCbits   SIM_BITS(TRISCbits_t, SFR_TRISC)
+#define STATUSbits  SIM_BITS(STATUSbits_t, SFR_STATUS)
+#define INTCONbits  SIM_BITS(INTCONbits_t, SFR_INTCON)
+#define PIR1bits    SIM_BITS(PIR1bits_t, SFR_PIR1)
+#define PIE1bits    SIM_BITS(PIE1bits_t, SFR_PIE1)
+#define T1CONbits   SIM_BITS(T1CONbits_t, SFR_T1CON)
+#define T2CONbits   SIM_BITS(T2CONbits_t, SFR_T2CON)
+#define WDTCONbits  SIM_BITS(WDTCONbits_t, SFR_WDTCON)
+#define OSCSTATbits SIM_BITS(OSCSTATbits_t, SFR_OSCSTAT)
+#define ADCON0bits  SIM_BITS(ADCON0bits_t, SFR_ADCON0)
+#define PMCON1bits  SIM_BITS(PMCON1bits_t, SFR_PMCON1)
+
+// Individual bit names
+#define nPD         STATUSbits.nPD
+#define nTO         STATUSbits.nTO
+#define GIE         INTCONbits.GIE
+#define PEIE        INTCONbits.PEIE
+#define TMR0IE      INTCONbits.TMR0IE
+#define IOCIE       INTCONbits.IOCIE
+#define TMR0IF      INTCONbits.TMR0IF
+#define IOCIF       INTCONbits.IOCIF
+#define TMR1IF      PIR1bits.TMR1IF
+#define TMR2IF      PIR1bits.TMR2IF
+#define ADIF        PIR1bits.ADIF
+#define TMR1IE      PIE1bits.TMR1IE
+#define TMR2IE      PIE1bits.TMR2IE
+#define ADIE        PIE1bits.ADIE
+#define TMR1ON      T1CONbits.TMR1ON
+#define TMR2ON      T2CONbits.TMR2ON
+#define SWDTEN      WDTCONbits.SWDTEN
+#define PLLRDY      OSCSTATbits.PLLRDY
+#define ADON        ADCON0bits.ADON
+#define GO          ADCON0bits.GO_nDONE
+#define RD          PMCON1bits.RD
+#define WR          PMCON1bits.WR
+#define WREN        PMCON1bits.WREN
+#define FREE        PMCON1bits.FREE
+#define LWLO        PMCON1bits.LWLO
+#define CFGS        PMCON1bits.CFGS
+
+// Compiler built-ins and intrinsic functions
+#define __interrupt(...)
+#define __persistent
+#define __at(addr)
+#define __section(name)
+
+#define di()        (GIE = 0)
+#define ei()        sim_ei()
+#define NOP()       sim_nop()
+#define CLRWDT()    sim_clrwdt()
+#define SLEEP()     sim_sleep()
+#define RESET()     sim_halt(SIM_HALT_RESET)
+
+#define __delay_us(x)   sim_delay((uint64_t)(x) * (_XTAL_FREQ / 4000000UL))
+#define __delay_ms(x)   sim_delay((uint64_t)(x) * (_XTAL_FREQ / 4000UL))
+
+// Busy-wait loop body (see UBMP420.h). Jump the virtual clock to the next
+// hardware event instead of spinning.
+#define WAIT_EVENT()    sim_wait_event()
+
+#endif